@@ -0,0 +1,123 @@
+/**
+ * @file BitmapPool.hpp
+ * @version 1.0
+ * @since Jul, 02.
+ * @date Jul, 02.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::BitmapPool Class
+ */
+
+#ifndef _BITMAPPOOL_HPP_
+#define _BITMAPPOOL_HPP_
+
+#include <cstdint>	// std::uint64_t
+#include "storage_pool.hpp"
+#include "SLPool.hpp"
+
+/**
+ * @brief The BitmapPool Class prototype
+ *
+ * A pool with the same block granularity as SLPool, but whose free blocks are
+ * kept in a dense bitmap (one bit per block, set when free) instead of a list
+ * threaded through the arena. Looking for room reads 64 blocks per word: the
+ * runs inside a word are found with scalar bit tricks (count-trailing-zeros,
+ * shifts and popcount); only whole words that are all used (or all free) are
+ * skipped several at a time with SSE2/AVX2, when the machine has them.
+ * Where each allocated area ends is kept in a second bitmap (one bit per
+ * block, set on the last block of a used area), so the client gets every byte
+ * of its blocks and the bookkeeping stays two bits per block.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	class BitmapPool : public StoragePool {
+
+		public:
+			enum {
+				BlockSize = SLPool::Block::BlockSize,	//!< Bytes per block.
+				WordBits = 64							//!< Blocks per bitmap word.
+			};
+
+			/**
+			 * @brief BitmapPool constructor
+			 * @param _b Number of bytes of the pool
+			 * @param _pt The allocation policy
+			 */
+			explicit BitmapPool( size_type _b,
+								 StoragePool::policy_type _pt = StoragePool::FIRST_FIT );
+
+			/**
+			 * @brief BitmapPool destructor
+			 */
+			~BitmapPool( );
+
+			/**
+			 * @brief Allocate memory using the First Fit algorithm
+			 * @param _b Number of bytes to be allocated
+			 * @return A pointer to the beggining of the allocated area
+			 */
+			void *Allocate( size_type _b );
+
+			/**
+			 * @brief Allocate memory using the Best Fit algorithm
+			 * @param _b Number of bytes to be allocated
+			 * @return A pointer to the beggining of the allocated area
+			 */
+			void *AllocateBF( size_type _b );
+
+			/**
+			 * @brief Free Memory
+			 * @param _p A pointer to element to be freed
+			 */
+			void Free( void *_p );
+
+			/**
+			 * @brief Function to show a visual representation from memory Blocks
+			 */
+			void view( );
+
+			/**
+			 * @brief Tells whether a pointer lies inside this pool's arena
+			 * @param _p The pointer to be checked
+			 */
+			bool Owns( const void *_p ) const {
+				return _p >= static_cast<const void *>(m_begin) and
+					   _p < static_cast<const void *>(m_begin + m_n_blocks * BlockSize);
+			}
+
+			/**
+			 * @brief Name of the word scanner picked for this machine
+			 * @return "avx2", "sse2" or "scalar"
+			 */
+			static const char *Engine( );
+
+		private:
+			//! First free block at or after _pos, or m_n_blocks.
+			size_type NextFree( size_type _pos ) const;
+
+			//! First used block at or after _pos, or m_n_blocks.
+			size_type NextUsed( size_type _pos ) const;
+
+			//! Last block of the used area holding block _pos.
+			size_type AreaEnd( size_type _pos ) const;
+
+			//! Marks _n blocks from _pos as free (or used).
+			void Mark( size_type _pos, size_type _n, bool _free );
+
+			//! Takes _n blocks from _pos and gives them to the client.
+			void *Take( size_type _pos, size_type _n );
+
+			size_type m_n_blocks;			//!< The number of blocks.
+			size_type m_n_words;			//!< The number of bitmap words.
+			char *m_raw;					//!< Raw area, as returned by new[].
+			char *m_begin;					//!< First block (aligned).
+			std::uint64_t *m_map;			//!< One bit per block, set when free.
+			std::uint64_t *m_ends;			//!< One bit per block, set on the last of a used area.
+			size_type m_hint;				//!< No free block lies before this word.
+	};
+}
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file FixedPool.hpp
+ * @version 1.0
+ * @since Jun, 28.
+ * @date Jun, 28.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::FixedPool Class
+ */
+
+#ifndef _FIXEDPOOL_HPP_
+#define _FIXEDPOOL_HPP_
+
+#include "storage_pool.hpp"
+
+/**
+ * @brief The FixedPool Class prototype
+ *
+ * A pool of equally sized slots. Free slots are chained through their own
+ * first bytes, so Allocate and Free are a single pop/push on that list and
+ * there is no per-slot Header.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	class FixedPool : public StoragePool {
+
+		public:
+			//! Alignment of every slot handed out by the pool.
+			enum { Align = 16 };
+
+			/**
+			 * @brief FixedPool constructor
+			 * @param _slot Size of each slot in bytes (rounded up to Align)
+			 * @param _n Number of slots in the pool
+			 */
+			FixedPool( size_type _slot, size_type _n );
+
+			/**
+			 * @brief FixedPool destructor
+			 */
+			~FixedPool( );
+
+			/**
+			 * @brief Allocate one slot
+			 * @param _b Number of bytes to be allocated (at most SlotSize())
+			 * @return A pointer to the beggining of the allocated slot
+			 */
+			void *Allocate( size_type _b );
+
+			/**
+			 * @brief Same as Allocate, every slot fits equally well
+			 * @param _b Number of bytes to be allocated
+			 * @return A pointer to the beggining of the allocated slot
+			 */
+			void *AllocateBF( size_type _b );
+
+			/**
+			 * @brief Free Memory
+			 * @param _p A pointer to the slot to be freed
+			 */
+			void Free( void *_p );
+
+			/**
+			 * @brief Function to show a visual representation of the slots
+			 */
+			void view( );
+
+			/**
+			 * @brief Tells whether a pointer lies inside this pool's arena
+			 * @param _p The pointer to be checked
+			 * @return True if _p was (or may have been) handed out by this pool
+			 */
+			bool Owns( const void *_p ) const {
+				return _p >= static_cast<const void *>(m_begin) and
+					   _p < static_cast<const void *>(m_end);
+			}
+
+			//! The size of each slot in bytes.
+			size_type SlotSize( ) const { return m_slot; }
+
+		private:
+			//! A free slot, linked to the next free one.
+			struct Slot {
+				Slot *m_next;	//!< The next free slot
+			};
+
+			size_type m_slot;		//!< Size of each slot.
+			size_type m_n_slots;	//!< Number of slots.
+			char *m_raw;			//!< Raw area, as returned by new[].
+			char *m_begin;			//!< First slot (aligned).
+			char *m_end;			//!< One past the last slot.
+			Slot *m_free;			//!< Head of the free list.
+	};
+}
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file FramePool.hpp
+ * @version 1.0
+ * @since Jul, 03.
+ * @date Jul, 03.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::FramePool Class and the gm::PooledFrame mixin
+ */
+
+#ifndef _FRAMEPOOL_HPP_
+#define _FRAMEPOOL_HPP_
+
+#include "storage_pool.hpp"
+#include "SLPool.hpp"
+
+/**
+ * @brief The FramePool Class prototype
+ *
+ * A SLPool fronted by one free list per block count. Every coroutine has a
+ * fixed frame size, so a frame given back is kept, header and all, on the list
+ * of its size and handed out as it is to the next frame of that coroutine:
+ * no search, no split and no merge once the program is warmed up. Only when
+ * a list is empty does the SLPool get asked, and only when the SLPool is full
+ * does the global operator new.
+ *
+ * A frame holds the resume and destroy pointers and the promise, so it is
+ * aligned as the global operator new aligns: every SLPool area is padded by
+ * SLPool::AlignPad, as the PoolRouter pads its medium areas.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	class FramePool : public StoragePool {
+
+		public:
+			enum {
+				Lists = 64,		//!< Frames of up to this many SLPool blocks are recycled.
+				Align = __STDCPP_DEFAULT_NEW_ALIGNMENT__	//!< Alignment of every frame.
+			};
+
+			/**
+			 * @brief FramePool constructor
+			 * @param _b Number of bytes of the SLPool behind the lists
+			 */
+			explicit FramePool( size_type _b = 1024 * 1024 );
+
+			/**
+			 * @brief FramePool destructor, the frames go with the SLPool
+			 */
+			~FramePool( ) { /*Empty*/ }
+
+			/**
+			 * @brief Allocate a frame
+			 * @param _b Number of bytes of the frame
+			 * @return A pointer to the beggining of the frame
+			 */
+			void *Allocate( size_type _b );
+
+			/**
+			 * @brief Same as Allocate, a recycled frame always fits exactly
+			 * @param _b Number of bytes of the frame
+			 * @return A pointer to the beggining of the frame
+			 */
+			void *AllocateBF( size_type _b );
+
+			/**
+			 * @brief Give a frame back, to the list of its size
+			 * @param _p A pointer to the frame
+			 */
+			void Free( void *_p );
+
+			/**
+			 * @brief Function to show the SLPool behind the lists
+			 */
+			void view( );
+
+			/**
+			 * @brief The calling thread's FramePool
+			 */
+			static FramePool &Local( );
+
+		private:
+			//! A recycled frame: the SLPool Header and padding stay, the link
+			//! is kept where the frame itself started.
+			struct Frame {
+				Frame *m_next;	//!< The next frame of the same size
+			};
+
+			//! Bytes kept for a frame of _b bytes: a freed frame must hold its link.
+			static size_type Room( size_type _b ) {
+				return _b < sizeof(Frame) ? sizeof(Frame) : _b;
+			}
+
+			//! Number of SLPool blocks behind a frame of _b bytes.
+			size_type BlocksOf( size_type _b ) const;
+
+			SLPool m_pool;			//!< Where new frames come from.
+			size_type m_pad;		//!< Bytes that align a SLPool area.
+			Frame *m_free[Lists];	//!< Recycled frames, by number of blocks.
+	};
+
+	/**
+	 * @brief Mixin for a coroutine's promise_type, so its frames come from
+	 *        the calling thread's FramePool
+	 *
+	 *     struct promise_type : gm::PooledFrame { ... };
+	 *
+	 * A frame must be destroyed by the thread that created it, while that
+	 * thread is still alive.
+	 */
+	struct PooledFrame {
+
+		static void *operator new( size_type _b ) {
+			return FramePool::Local( ).Allocate(_b);
+		}
+
+		static void operator delete( void *_p ) {
+			FramePool::Local( ).Free(_p);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file GenPool.hpp
+ * @version 1.0
+ * @since Jul, 04.
+ * @date Jul, 04.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::GenPool Class
+ */
+
+#ifndef _GENPOOL_HPP_
+#define _GENPOOL_HPP_
+
+#include <cstdint>	// std::uint32_t, std::uint64_t
+#include "storage_pool.hpp"
+#include "SLPool.hpp"
+
+/**
+ * @brief The GenPool Class prototype
+ *
+ * A pool that keeps short-lived and long-lived areas apart, so the short ones
+ * do not leave holes between the long ones:
+ *  - short-lived areas are bumped, one after the other, into small regions.
+ *    A region only counts its live areas; when the last one is freed the
+ *    whole region is reset at once and bumped into again;
+ *  - long-lived areas (and short ones that find every region busy) go to a
+ *    SLPool.
+ * Every area, long-lived or not, starts at a multiple of Align.
+ * The lifetime comes from AllocateHinted (or new(pool, hint)). Without a hint
+ * the pool either assumes LONG_LIVED or, in predicting mode, guesses from the
+ * lifetimes seen so far for areas of a similar size.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	class GenPool : public StoragePool {
+
+		public:
+			enum {
+				Regions = 8,			//!< Number of short-lived regions.
+				Classes = 32,			//!< Size classes of the predictor (powers of 2).
+				Align = 16				//!< Granularity of the bumps in a region.
+			};
+
+			/**
+			 * @brief GenPool constructor
+			 * @param _short Bytes split among the short-lived regions
+			 * @param _long Bytes of the SLPool for long-lived areas
+			 * @param _predict Whether unhinted allocations are predicted by size
+			 * @param _limit Lifetime, in allocations, below which an area is short-lived
+			 */
+			GenPool( size_type _short, size_type _long,
+					 bool _predict = false, size_type _limit = 64 );
+
+			/**
+			 * @brief GenPool destructor
+			 */
+			~GenPool( );
+
+			/**
+			 * @brief Allocate memory with no hint
+			 * @param _b Number of bytes to be allocated
+			 * @return A pointer to the beggining of the allocated area
+			 */
+			void *Allocate( size_type _b );
+
+			/**
+			 * @brief Same as Allocate, the SLPool uses Best Fit
+			 * @param _b Number of bytes to be allocated
+			 * @return A pointer to the beggining of the allocated area
+			 */
+			void *AllocateBF( size_type _b );
+
+			/**
+			 * @brief Allocate memory in the region matching a lifetime
+			 * @param _b Number of bytes to be allocated
+			 * @param _lt The expected lifetime
+			 * @return A pointer to the beggining of the allocated area
+			 */
+			void *AllocateHinted( size_type _b, lifetime_type _lt );
+
+			/**
+			 * @brief Free Memory
+			 * @param _p A pointer to element to be freed
+			 */
+			void Free( void *_p );
+
+			/**
+			 * @brief Function to show the regions and the long-lived SLPool
+			 */
+			void view( );
+
+			/**
+			 * @brief Free space that can still be handed out
+			 * @param _free Free bytes: unbumped room of the regions and the SLPool's
+			 * @param _largest Bytes of the largest single free area
+			 */
+			void FreeStats( size_type &_free, size_type &_largest ) const;
+
+			//! The SLPool that holds the long-lived areas.
+			const SLPool &LongPool( ) const { return m_long; }
+
+			//! Number of times a region emptied and was reset.
+			size_type Resets( ) const { return m_resets; }
+
+		private:
+			//! Kept in front of every area.
+			struct Header {
+				std::uint32_t m_region;		//!< Region index, or LongRegion.
+				std::uint32_t m_class;		//!< Size class, for the predictor.
+				std::uint64_t m_birth;		//!< Allocation clock at birth.
+			};
+
+			static_assert( sizeof(Header) % Align == 0, "the client's area must follow the Header aligned" );
+
+			enum { LongRegion = 0xFFFFFFFFu };
+
+			//! A short-lived region.
+			struct Region {
+				char *m_begin;				//!< First byte.
+				size_type m_used;			//!< Bytes bumped so far.
+				size_type m_live;			//!< Areas not freed yet.
+			};
+
+			//! Bumps an area into a short-lived region, or returns nullptr.
+			Header *BumpShort( size_type _need );
+
+			//! Places an area of _b bytes by lifetime; _best picks Best Fit in the SLPool.
+			void *Place( size_type _b, lifetime_type _lt, bool _best );
+
+			//! Predicted lifetime for an area of _b bytes.
+			lifetime_type Predict( size_type _b ) const;
+
+			//! Size class of _b bytes.
+			static std::uint32_t ClassOf( size_type _b );
+
+			size_type m_region_size;		//!< Bytes of each region.
+			char *m_raw;					//!< Raw area of the regions.
+			Region m_regions[Regions];		//!< The short-lived regions.
+			size_type m_current;			//!< Region being bumped into.
+			SLPool m_long;					//!< The long-lived areas.
+			size_type m_pad;				//!< Bytes that align a SLPool area.
+			bool m_predict;					//!< Whether to predict unhinted lifetimes.
+			size_type m_limit;				//!< Short-lived lifetime limit.
+			std::uint64_t m_clock;			//!< Allocations so far.
+			double m_lifetime[Classes];		//!< Average lifetime seen per size class.
+			size_type m_resets;				//!< Regions reset so far.
+	};
+}
+
+#endif
@@ -0,0 +1,189 @@
+/**
+ * @file ObjectPool.hpp
+ * @version 1.0
+ * @since Jul, 05.
+ * @date Jul, 05.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::ObjectPool Class
+ */
+
+#ifndef _OBJECTPOOL_HPP_
+#define _OBJECTPOOL_HPP_
+
+#include <cassert>		// assert
+#include <cstdint>		// std::uintptr_t
+#include <memory>		// std::unique_ptr
+#include <new>			// placement new
+#include <utility>		// std::forward
+#include "storage_pool.hpp"
+
+/**
+ * @brief The ObjectPool Class prototype
+ *
+ * A cache of already built objects of type T. Acquire hands out a cached
+ * object when there is one, after nothing more than the reset it got when it
+ * came back; only when the cache is empty is a new object built, in the next
+ * free slot of a slab. Slabs are taken from a StoragePool, each twice as big
+ * as the last, so the objects sit side by side. Objects are destroyed only
+ * with the ObjectPool.
+ *
+ * Handles are std::unique_ptr whose deleter gives the object back to the
+ * pool, so every handle must be gone before the pool is.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	/**
+	 * @brief How an object given back to an ObjectPool is made ready again.
+	 *        By default it calls the object's reset(); specialize it for
+	 *        types that are reset some other way.
+	 */
+	template < typename T >
+	struct object_reset {
+		static void reset( T &_t ) { _t.reset( ); }
+	};
+
+	template < typename T, typename Reset = object_reset<T> >
+	class ObjectPool {
+
+		public:
+			//! Gives an object back to its pool.
+			class Deleter {
+				public:
+					Deleter( ObjectPool *_pool = nullptr ) : m_pool(_pool) { /*Empty*/ }
+					void operator()( T *_t ) const { m_pool->Release(_t); }
+				private:
+					ObjectPool *m_pool;		//!< The owner of the object
+			};
+
+			//! An object lent by the pool.
+			typedef std::unique_ptr<T, Deleter> handle_type;
+
+			/**
+			 * @brief ObjectPool constructor
+			 * @param _pool Where the slabs come from
+			 * @param _first Number of objects in the first slab
+			 */
+			explicit ObjectPool( StoragePool &_pool, size_type _first = 16 ) :
+				m_pool(_pool), m_slabs(nullptr), m_cache(nullptr),
+				m_next_count(_first == 0 ? 1 : _first), m_lent(0) { /*Empty*/ }
+
+			ObjectPool( const ObjectPool & ) = delete;
+			ObjectPool &operator=( const ObjectPool & ) = delete;
+
+			/**
+			 * @brief ObjectPool destructor, destroys every object built
+			 */
+			~ObjectPool( ) {
+				assert( m_lent == 0 && "every handle must be gone before its ObjectPool" );
+				while ( m_slabs != nullptr ) {
+					Slab *slab = m_slabs;
+					m_slabs = slab->m_next;
+					for ( size_type i = 0; i < slab->m_built; i++ )
+						slab->m_slots[i].object( )->~T( );
+					m_pool.Free(slab->m_raw);
+				}
+			}
+
+			/**
+			 * @brief Lends an object, building it only if none is cached
+			 * @param _args Arguments for T's constructor, used only when an
+			 *        object has to be built
+			 * @return A handle that gives the object back when it goes
+			 */
+			template < typename... Args >
+			handle_type Acquire( Args &&... _args ) {
+
+				Slot *slot = m_cache;
+				if ( slot != nullptr ) {
+					m_cache = slot->m_next;
+				}
+				else {
+					if ( m_slabs == nullptr or m_slabs->m_built == m_slabs->m_count )
+						Grow( );
+					slot = &m_slabs->m_slots[m_slabs->m_built];
+					::new (static_cast<void *>(slot->m_storage)) T( std::forward<Args>(_args)... );
+					m_slabs->m_built++;
+				}
+
+				m_lent++;
+				return handle_type( slot->object( ), Deleter(this) );
+			}
+
+			//! Number of objects built so far.
+			size_type Built( ) const {
+				size_type built = 0;
+				for ( Slab *slab = m_slabs; slab != nullptr; slab = slab->m_next )
+					built += slab->m_built;
+				return built;
+			}
+
+			//! Number of objects lent and not given back yet.
+			size_type Lent( ) const { return m_lent; }
+
+		private:
+			//! Room for one object, linked to the next cached one.
+			struct Slot {
+				alignas(T) unsigned char m_storage[sizeof(T)];	//!< The object
+				Slot *m_next;									//!< Next cached slot
+
+				T *object( ) { return reinterpret_cast<T *>(m_storage); }
+			};
+
+			//! A contiguous run of slots.
+			struct Slab {
+				void *m_raw;			//!< The area from the StoragePool
+				Slab *m_next;			//!< The previous (smaller) slab
+				Slot *m_slots;			//!< First slot, aligned for T
+				size_type m_count;		//!< Number of slots
+				size_type m_built;		//!< Slots holding an object, from the first
+			};
+
+			//! First address at or after _p that is a multiple of _align.
+			static char *AlignUp( char *_p, size_type _align ) {
+				auto addr = reinterpret_cast<std::uintptr_t>(_p);
+				return _p + (_align - addr % _align) % _align;
+			}
+
+			//! Takes a new slab, twice as big as the last one, from the StoragePool.
+			void Grow( ) {
+				size_type bytes = alignof(Slab) + sizeof(Slab) + alignof(Slot)
+								  + m_next_count * sizeof(Slot);
+				auto *raw = static_cast<char *>(
+					m_pool.m_policy == StoragePool::BEST_FIT ? m_pool.AllocateBF(bytes)
+															 : m_pool.Allocate(bytes) );
+
+				// Pools only promise the alignment of their blocks, so both the
+				// Slab and its slots are aligned by hand.
+				auto *slab = reinterpret_cast<Slab *>(AlignUp(raw, alignof(Slab)));
+				slab->m_raw = raw;
+				slab->m_slots = reinterpret_cast<Slot *>(
+					AlignUp(reinterpret_cast<char *>(slab + 1), alignof(Slot)) );
+				slab->m_count = m_next_count;
+				slab->m_built = 0;
+				slab->m_next = m_slabs;
+				m_slabs = slab;
+				m_next_count *= 2;
+			}
+
+			//! Resets an object and caches it for the next Acquire.
+			void Release( T *_t ) {
+				Reset::reset(*_t);
+				Slot *slot = reinterpret_cast<Slot *>(_t);
+				slot->m_next = m_cache;
+				m_cache = slot;
+				m_lent--;
+			}
+
+			StoragePool &m_pool;		//!< Where the slabs come from.
+			Slab *m_slabs;				//!< Newest slab first.
+			Slot *m_cache;				//!< Built objects ready to be lent.
+			size_type m_next_count;		//!< Slots of the next slab.
+			size_type m_lent;			//!< Objects lent right now.
+	};
+}
+
+#endif
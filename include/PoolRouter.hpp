@@ -0,0 +1,115 @@
+/**
+ * @file PoolRouter.hpp
+ * @version 1.0
+ * @since Jun, 28.
+ * @date Jun, 28.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::PoolRouter Class
+ */
+
+#ifndef _POOLROUTER_HPP_
+#define _POOLROUTER_HPP_
+
+#include "storage_pool.hpp"
+#include "FixedPool.hpp"
+#include "SLPool.hpp"
+
+/**
+ * @brief The PoolRouter Class prototype
+ *
+ * A front end that owns one pool per size range and dispatches to them:
+ *  - small sizes (up to MaxSmall) go to a FixedPool per size class;
+ *  - medium sizes (below HugeSize) go to a SLPool;
+ *  - huge sizes are mapped straight from the operational system.
+ * A tier that runs out of room spills its request to the next one.
+ * Free finds the owner by address range, so a single new(router) covers
+ * every size.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	class PoolRouter : public StoragePool {
+
+		public:
+			enum {
+				Align = FixedPool::Align,	//!< Alignment of every pointer handed out.
+				NumClasses = 5,				//!< Small size classes: 16, 32, 64, 128, 256.
+				MaxSmall = 256,				//!< Largest size served by a FixedPool.
+				HugeSize = 128 * 1024		//!< Sizes from here on are mapped directly.
+			};
+
+			/**
+			 * @brief PoolRouter constructor
+			 * @param _slots Number of slots in each small size class
+			 * @param _b Number of bytes of the medium SLPool
+			 * @param _pt Allocation policy of the medium SLPool
+			 * @param _map_huge Whether huge sizes are mapped, or rejected with
+			 *        std::bad_alloc so the caller can serve them elsewhere
+			 */
+			explicit PoolRouter( size_type _slots = 1024,
+								 size_type _b = 1024 * 1024,
+								 StoragePool::policy_type _pt = StoragePool::FIRST_FIT,
+								 bool _map_huge = true );
+
+			/**
+			 * @brief PoolRouter destructor
+			 */
+			~PoolRouter( );
+
+			/**
+			 * @brief Allocate memory from the pool matching the size
+			 * @param _b Number of bytes to be allocated
+			 * @return A pointer to the beggining of the allocated area
+			 */
+			void *Allocate( size_type _b );
+
+			/**
+			 * @brief Allocate memory, using Best Fit on the medium pool
+			 * @param _b Number of bytes to be allocated
+			 * @return A pointer to the beggining of the allocated area
+			 */
+			void *AllocateBF( size_type _b );
+
+			/**
+			 * @brief Free Memory, in whichever pool owns the address
+			 * @param _p A pointer to element to be freed
+			 */
+			void Free( void *_p );
+
+			/**
+			 * @brief Function to show a visual representation of every sub-pool
+			 */
+			void view( );
+
+			/**
+			 * @brief Tells whether a pointer lies inside a small or medium arena
+			 * @param _p The pointer to be checked
+			 * @return True if _p belongs to a FixedPool or to the SLPool
+			 */
+			bool Owns( const void *_p ) const;
+
+			/**
+			 * @brief Number of bytes the client may use in an allocated area
+			 * @param _p A pointer returned by Allocate or AllocateBF
+			 * @return The usable size of the area, in bytes
+			 */
+			size_type UsableSize( const void *_p ) const;
+
+		private:
+			//! Allocates from the small/medium tiers, spilling when one is full.
+			void *Route( size_type _b, bool _best );
+
+			//! Maps a huge area straight from the operational system.
+			void *MapHuge( size_type _b );
+
+			FixedPool *m_small[NumClasses];	//!< One pool per small size class.
+			SLPool m_medium;				//!< The pool for medium sizes.
+			size_type m_pad;				//!< Bytes that align a SLPool area.
+			bool m_map_huge;				//!< Whether huge sizes are mapped.
+	};
+}
+
+#endif
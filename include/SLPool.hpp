@@ -28,11 +28,27 @@ namespace gm
 	class SLPool : public StoragePool {
 	
 		public:
+			/**
+			 * @brief When freed blocks are merged with their free neighbours
+			 *
+			 * EAGER merges on every Free. DEFERRED keeps small freed areas on
+			 * per-size quick lists, reused as they are by Allocate, and merges
+			 * them all in one sorted pass once too many are waiting or an
+			 * allocation does not fit.
+			 */
+			enum coalesce_type { EAGER, DEFERRED };
+
+			enum {
+				QuickLists = 8,			//!< Areas up to this many blocks are kept on quick lists.
+				QuickThreshold = 64		//!< Quick-listed areas that trigger a merge pass.
+			};
+
 			/**
 			 * @brief SLPool constructor
           	 */
 			explicit SLPool( size_type _b,
-							 StoragePool::policy_type _pt = StoragePool::FIRST_FIT );
+							 StoragePool::policy_type _pt = StoragePool::FIRST_FIT,
+							 coalesce_type _ct = EAGER );
   
           	/**
           	 * @brief SLPool destructor
@@ -63,6 +79,51 @@ namespace gm
           	 * @brief Function to show a visual representation from memory Blocks
           	 */
           	void view( );
+
+			/**
+			 * @brief Merges every quick-listed area back into the free list
+			 */
+			void Consolidate( );
+
+			/**
+			 * @brief Tells whether a pointer lies inside this pool's arena
+			 * @param _p The pointer to be checked
+			 * @return True if _p was (or may have been) handed out by this pool
+			 */
+			bool Owns( const void *_p ) const;
+
+			/**
+			 * @brief Number of bytes the client may use in an allocated area
+			 * @param _p A pointer returned by Allocate or AllocateBF
+			 * @return The usable size of the area, in bytes
+			 */
+			size_type UsableSize( const void *_p ) const;
+
+			/**
+			 * @brief Free space of the pool, walking the free list
+			 * @param _free Total free bytes, quick-listed areas included
+			 * @param _largest Bytes of the largest free area in the list
+			 */
+			void FreeStats( size_type &_free, size_type &_largest ) const;
+
+			/**
+			 * @brief Padding that aligns every area of this pool: blocks are
+			 *        BlockSize bytes apart and areas start right after the
+			 *        Header, so they all sit at the same offset modulo _align
+			 * @param _align The alignment wanted, a divisor of BlockSize
+			 * @return Bytes to skip from any area so it starts at a multiple of _align
+			 */
+			size_type AlignPad( size_type _align ) const;
+
+			/**
+			 * @brief Writes a binary map of the arena (see heap_map.hpp) in one
+			 *        pass, without allocating, so it can be taken on a live pool
+			 * @param _buf Where the map is written
+			 * @param _len Bytes available at _buf
+			 * @return Bytes the whole map takes; when more than _len, only the
+			 *         records that fit were written, and the header counts those
+			 */
+			size_type snapshot( void *_buf, size_type _len );
   
           	/**
           	 * @brief The header of the memory block
@@ -90,18 +151,30 @@ namespace gm
                   	
                   	Block *m_next;  //!< A pointer to the next block
                   	
-                  	//! The allocated memory
-                  	char m_raw[ BlockSize - sizeof(Header) ]; // Client's raw area
+                  	//! The allocated memory, it starts right after the Header
+                  	//! (the padding before m_next is the client's too).
+                  	char m_raw[ BlockSize - sizeof(Block *) ]; // Client's raw area
               	};
   
               	//! The Block constructor
               	Block( ) : Header( ), m_next(nullptr) { /*Empty*/ };
           	};
+
+			static_assert( sizeof(Block) == Block::BlockSize, "blocks must be BlockSize bytes apart" );
 			
 		private:
+			//! Takes a quick-listed area of _n blocks, or nullptr.
+			Block *QuickPop( uint _n );
+
+			//! Sorts a list of blocks by address.
+			static Block *SortByAddress( Block *_list );
+
 	 		uint m_n_blocks;			//!< The number of blocks
     		Block *m_pool;				//!< Head of list.
     		Block &m_sentinel;			//!< End of the list.
+			coalesce_type m_coalesce;	//!< When freed blocks are merged.
+			Block *m_quick[QuickLists];	//!< Freed areas of 1..QuickLists blocks, not merged yet.
+			uint m_n_quick;				//!< Number of quick-listed areas.
 	};
 }
 
@@ -0,0 +1,56 @@
+/**
+ * @file heap_map.hpp
+ * @version 1.0
+ * @since Jul, 06.
+ * @date Jul, 06.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title Binary heap map format
+ */
+
+#ifndef _HEAP_MAP_HPP_
+#define _HEAP_MAP_HPP_
+
+#include <cstdint>	// std::uint16_t, std::uint32_t
+
+/**
+ * @brief Layout of the heap maps written by SLPool::snapshot and read by
+ *        the heapmap tool
+ *
+ * A HeapMapHeader followed by m_records HeapMapRecords, one per area of the
+ * arena (free or used), in address order. Fields are in the byte order of the
+ * machine that wrote the map. Offsets and lengths count blocks, and
+ * m_block_size is the distance in bytes from one block to the next, so an
+ * area starts m_offset * m_block_size bytes into the arena and spans
+ * m_length * m_block_size bytes, the pool's own header included.
+ */
+
+namespace gm
+{
+	enum {
+		HeapMapMagic = 0x4D484D47,		//!< "GMHM", read as little-endian.
+		HeapMapVersion = 1
+	};
+
+	//! Start of a heap map.
+	struct HeapMapHeader {
+		std::uint32_t m_magic;			//!< HeapMapMagic.
+		std::uint16_t m_version;		//!< HeapMapVersion.
+		std::uint16_t m_block_size;		//!< Bytes from one block to the next.
+		std::uint32_t m_blocks;			//!< Blocks of the arena.
+		std::uint32_t m_records;		//!< Records that follow.
+	};
+
+	//! One area of the arena.
+	struct HeapMapRecord {
+		enum : std::uint32_t { FreeBit = 0x80000000u };	//!< Set in m_length for a free area.
+
+		std::uint32_t m_offset;			//!< First block of the area.
+		std::uint32_t m_length;			//!< Blocks of the area, and the FreeBit.
+	};
+
+	static_assert( sizeof(HeapMapHeader) == 16, "heap map header must be 16 bytes" );
+	static_assert( sizeof(HeapMapRecord) == 8, "heap map record must be 8 bytes" );
+}
+
+#endif
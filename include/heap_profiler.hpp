@@ -0,0 +1,87 @@
+/**
+ * @file heap_profiler.hpp
+ * @version 1.0
+ * @since Jul, 01.
+ * @date Jul, 01.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::HeapProfiler Class
+ */
+
+#ifndef _HEAP_PROFILER_HPP_
+#define _HEAP_PROFILER_HPP_
+
+#include <iostream>
+#include <cstddef>	// std::ptrdiff_t
+#include <cstdint>	// std::uintptr_t
+#include "storage_pool.hpp"
+
+/**
+ * @brief The HeapProfiler Class prototype
+ *
+ * Sampling profiler of the new(pool) operators. Every thread counts down the
+ * bytes it asks from the pools and, when the count runs out, the allocation
+ * that crossed it has its backtrace recorded. The next count is drawn from an
+ * exponential distribution with mean Interval(), as tcmalloc does, so every
+ * byte is equally likely to be sampled and big allocations are caught more
+ * often. A sampled object is tracked until it is freed.
+ *
+ * While the profiler is off the countdown is simply set far ahead, so the
+ * cost on the allocation path stays a single thread-local decrement.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	class HeapProfiler {
+
+		public:
+			//! Bit set in a Tag's pool pointer when its object was sampled.
+			enum { SampledBit = 1 };
+
+			/**
+			 * @brief Turns sampling on (or off)
+			 * @param _b Mean number of bytes between samples, 0 turns it off
+			 */
+			static void SetInterval( size_type _b );
+
+			//! Mean number of bytes between samples, 0 when off.
+			static size_type Interval( );
+
+			/**
+			 * @brief Slow path, called once the thread's countdown runs out
+			 * @param _p The client's area
+			 * @param _b Number of bytes asked by the client
+			 * @param _pool The pool the area came from
+			 * @return True if the object was sampled and must be tagged
+			 */
+			static bool Sample( void *_p, size_type _b, StoragePool *_pool );
+
+			/**
+			 * @brief Stops tracking a sampled object
+			 * @param _p The client's area, as given to Sample
+			 */
+			static void Release( void *_p );
+
+			/**
+			 * @brief Writes the live sampled objects as folded stacks
+			 *        ("pool;caller;...;callee bytes"), with estimated bytes
+			 * @param _os The output stream
+			 */
+			static void DumpFolded( std::ostream &_os );
+
+			/**
+			 * @brief Writes the live sampled objects as a legacy pprof heap profile
+			 * @param _os The output stream
+			 */
+			static void DumpPprof( std::ostream &_os );
+
+			//! Bytes left before the thread's next sample. Defined inline with
+			//! a constant initializer, so every translation unit reaches it
+			//! straight through %fs, with no TLS wrapper call.
+			static inline thread_local std::ptrdiff_t t_countdown = 0;
+	};
+}
+
+#endif
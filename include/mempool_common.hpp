@@ -12,7 +12,9 @@
 #define _MEMPOOL_COMMON_HPP_
 
 #include <cstdio>  // std::size_t
+#include <cstdint> // std::uintptr_t
 #include "storage_pool.hpp"
+#include "heap_profiler.hpp"
 
 typedef std::size_t size_type;
 
@@ -24,6 +26,37 @@ typedef std::size_t size_type;
         StoragePool *pool;  //!< A reference to the Pool
     };
 
+/**
+ *  @brief Counts a pool allocation for the heap profiler, and marks the Tag
+    of the sampled ones (the low bit of a pool pointer is always free).
+    Always inlined, so it never shows up as a frame of the sampled stacks.
+ */
+    __attribute__((always_inline))
+    inline void *sample_tag(Tag *tag, size_type bytes) {
+        void *raw = reinterpret_cast<void *>(tag + 1U);
+        if ((gm::HeapProfiler::t_countdown -= bytes) < 0 and
+            gm::HeapProfiler::Sample(raw, bytes, tag->pool))
+            tag->pool = reinterpret_cast<StoragePool *>(
+                reinterpret_cast<std::uintptr_t>(tag->pool) | gm::HeapProfiler::SampledBit);
+        return raw;
+    }
+
+/**
+ *  @brief Gives back the memory behind a Tag to its owner
+ */
+    inline void release_tag(Tag *tag) {
+        auto bits = reinterpret_cast<std::uintptr_t>(tag->pool);
+        if (bits & gm::HeapProfiler::SampledBit) {
+            gm::HeapProfiler::Release(tag + 1U);
+            bits &= ~std::uintptr_t(gm::HeapProfiler::SampledBit);
+        }
+        StoragePool *pool = reinterpret_cast<StoragePool *>(bits);
+        if (nullptr != pool)  // Memory block belongs to a particular GM.
+            pool->Free(tag);
+        else
+            std::free(tag);  // Memory block belongs to the operational system.
+    }
+
     void *operator new(size_type bytes, StoragePool &p) {
 
 		Tag *tag = nullptr;
@@ -37,7 +70,7 @@ typedef std::size_t size_type;
 		}
         tag->pool = &p;
         // skip sizeof tag to get the raw data-block.
-        return reinterpret_cast<void *>(tag + 1U);
+        return sample_tag(tag, bytes);
     }
 
     void *operator new[](size_type bytes, StoragePool &p) {
@@ -52,7 +85,25 @@ typedef std::size_t size_type;
 		}
 		tag->pool = &p;
         // skip sizeof tag to get the raw data-block.
-        return reinterpret_cast<void *>(tag + 1U);
+        return sample_tag(tag, bytes);
+    }
+
+    void *operator new(size_type bytes, StoragePool &p, StoragePool::lifetime_type hint) {
+
+		size_type new_size = bytes + sizeof(Tag);
+		Tag *tag = reinterpret_cast<Tag *>(p.AllocateHinted(new_size, hint));
+		tag->pool = &p;
+        // skip sizeof tag to get the raw data-block.
+        return sample_tag(tag, bytes);
+    }
+
+    void *operator new[](size_type bytes, StoragePool &p, StoragePool::lifetime_type hint) {
+
+		size_type new_size = bytes + sizeof(Tag);
+		Tag *tag = reinterpret_cast<Tag *>(p.AllocateHinted(new_size, hint));
+		tag->pool = &p;
+        // skip sizeof tag to get the raw data-block.
+        return sample_tag(tag, bytes);
     }
 
     void *operator new(size_type bytes) {  // Regular new
@@ -76,10 +127,7 @@ typedef std::size_t size_type;
         // points to the raw data (second block of information).
         // The pool id (tag) is located "sizeof (Tag)" bytes before.
         Tag * const tag = reinterpret_cast<Tag *>(arg) - 1U;
-        if (nullptr != tag->pool)  // Memory block belongs to a particular GM.
-            tag->pool->Free(tag);
-        else
-            std::free(tag);  // Memory block belongs to the operational system.
+        release_tag(tag);
     }
 
     void operator delete[](void *arg) noexcept {
@@ -87,10 +135,16 @@ typedef std::size_t size_type;
         // points to the raw data (second block of information).
         // The pool id (tag) is located "sizeof (Tag)" bytes before.
         Tag * const tag = reinterpret_cast<Tag *>(arg) - 1U;
-        if (nullptr != tag->pool)  // Memory block belongs to a particular GM.
-            tag->pool->Free(tag);
-        else
-            std::free(tag);  // Memory block belongs to the operational system.
+        release_tag(tag);
+    }
+
+    // Sized deletes (C++14 on): the Tag already knows where the block goes.
+    void operator delete(void *arg, size_type) noexcept {
+        ::operator delete(arg);
+    }
+
+    void operator delete[](void *arg, size_type) noexcept {
+        ::operator delete[](arg);
     }
 
 #endif
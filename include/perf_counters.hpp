@@ -0,0 +1,105 @@
+/**
+ * @file perf_counters.hpp
+ * @version 1.0
+ * @since Jun, 30.
+ * @date Jun, 30.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::PerfCounters Class
+ */
+
+#ifndef _PERF_COUNTERS_HPP_
+#define _PERF_COUNTERS_HPP_
+
+#include <iostream>
+#include <cstdio>	// std::size_t
+
+/**
+ * @brief The PerfCounters Class prototype
+ *
+ * Hardware performance counters of the calling thread, read through Linux'
+ * perf_event_open. Each counter is opened on its own, so a counter that the
+ * machine (or the kernel's permissions) does not offer is simply reported as
+ * unavailable, while the others keep working. On other systems every counter
+ * is unavailable.
+ */
+
+namespace gm
+{
+	typedef std::size_t size_type;
+
+	class PerfCounters {
+
+		public:
+			//! The counted events.
+			enum event_type {
+				CYCLES,
+				INSTRUCTIONS,
+				L1D_MISSES,
+				LLC_MISSES,
+				BRANCH_MISSES,
+				DTLB_MISSES,
+				NumEvents
+			};
+
+			/**
+			 * @brief PerfCounters constructor, opens every counter it can
+			 */
+			PerfCounters( );
+
+			/**
+			 * @brief PerfCounters destructor, closes the counters
+			 */
+			~PerfCounters( );
+
+			PerfCounters( const PerfCounters & ) = delete;
+			PerfCounters &operator=( const PerfCounters & ) = delete;
+
+			/**
+			 * @brief Resets and starts every available counter
+			 */
+			void Start( );
+
+			/**
+			 * @brief Stops every available counter and reads their values
+			 */
+			void Stop( );
+
+			/**
+			 * @brief Tells whether a counter could be opened
+			 * @param _e The event
+			 */
+			bool Available( event_type _e ) const { return m_fd[_e] != -1; }
+
+			/**
+			 * @brief Tells whether at least one counter could be opened
+			 */
+			bool Any( ) const;
+
+			/**
+			 * @brief Value of a counter in the last Start/Stop window
+			 * @param _e The event
+			 * @return The count, scaled when the kernel multiplexed the counter
+			 */
+			double Value( event_type _e ) const { return m_value[_e]; }
+
+			/**
+			 * @brief Prints every counter divided by a number of operations
+			 * @param _os The output stream
+			 * @param _ops Number of operations in the last Start/Stop window
+			 */
+			void Report( std::ostream &_os, double _ops ) const;
+
+			/**
+			 * @brief Short name of an event, as printed by Report
+			 * @param _e The event
+			 */
+			static const char *Name( event_type _e );
+
+		private:
+			int m_fd[NumEvents];			//!< File descriptors, -1 if unavailable.
+			double m_value[NumEvents];		//!< Values read by the last Stop.
+	};
+}
+
+#endif
@@ -28,6 +28,8 @@ class StoragePool{
 	public:
 		//!< Policy type
 		enum policy_type { FIRST_FIT, BEST_FIT };
+		//!< Expected lifetime of an allocation, as hinted by the client.
+		enum lifetime_type { SHORT_LIVED, LONG_LIVED, UNKNOWN_LIFETIME };
         /**
          * @brief StoragePool destructor
          */
@@ -47,6 +49,17 @@ class StoragePool{
          */
 		virtual void *AllocateBF( size_type _b ) = 0;
 
+		/**
+         * @brief Allocates memory, with a hint of how long it will live
+		 * @param _b Number of bytes to be allocated
+		 * @param _lt The expected lifetime; pools that do not use it ignore it
+		 * @return A pointer to the beggining of the allocated area
+         */
+		virtual void *AllocateHinted( size_type _b, lifetime_type _lt ) {
+			(void) _lt;
+			return m_policy == BEST_FIT ? AllocateBF(_b) : Allocate(_b);
+		}
+
 		/**
 		 * @brief Free memory
 		 * @param _p A pointer to element to be freed
@@ -0,0 +1,346 @@
+/**
+ * @file gremlins_preload.cpp
+ * @version 1.0
+ * @since Jun, 29.
+ * @date Jun, 29.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title Replacement of the C allocation functions by GREMLINS pools
+ *
+ * Built as a shared library, to be loaded ahead of the C library:
+ *
+ *     LD_PRELOAD=build/lib/libgremlins.so ./some_program
+ *
+ * malloc, free, calloc, realloc, posix_memalign (and friends) and the C++
+ * new/delete operators are served from a single gm::PoolRouter guarded by a
+ * mutex. Whatever the pools can not serve (huge sizes, large alignments or
+ * a full pool) falls back to the next definition, usually the C library's.
+ *
+ * The pools are built lazily, on the first allocation. While that happens,
+ * and while the real functions are being looked up, requests are served by
+ * a small static buffer that is never given back.
+ *
+ * Environment variables:
+ *  - GREMLINS_SLOTS: number of slots in each small size class;
+ *  - GREMLINS_POOL_BYTES: number of bytes of the medium SLPool.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     // To RTLD_NEXT
+#endif
+
+#include <cassert>      // To assert
+#include <cerrno>       // To ENOMEM, EINVAL
+#include <cstddef>      // To std::max_align_t
+#include <cstdint>      // To std::uintptr_t
+#include <cstdlib>      // To std::getenv, std::strtoull
+#include <cstring>      // To std::memcpy, std::memset
+#include <atomic>       // To std::atomic
+#include <mutex>        // To std::mutex
+#include <new>          // To std::bad_alloc, std::nothrow_t
+#include <dlfcn.h>      // To dlsym
+#include <pthread.h>    // To pthread_atfork
+#include "PoolRouter.hpp"
+
+using namespace gm;
+
+#define GM_EXPORT extern "C" __attribute__((visibility("default")))
+
+namespace {
+
+    typedef void *(*malloc_type)( size_type );
+    typedef void (*free_type)( void * );
+    typedef void *(*calloc_type)( size_type, size_type );
+    typedef void *(*realloc_type)( void *, size_type );
+    typedef int (*memalign_type)( void **, size_type, size_type );
+    typedef size_type (*usable_type)( void * );
+
+    //! The next definition of each function, usually the C library's.
+    malloc_type real_malloc = nullptr;
+    free_type real_free = nullptr;
+    calloc_type real_calloc = nullptr;
+    realloc_type real_realloc = nullptr;
+    memalign_type real_memalign = nullptr;
+    usable_type real_usable = nullptr;
+
+    enum { Align = PoolRouter::Align };
+    static_assert( Align >= alignof(std::max_align_t), "malloc must align for any type" );
+
+    //! Bootstrap buffer, used while the real functions are being found.
+    alignas(Align) char g_boot[64 * 1024];
+    size_type g_boot_used = 0;
+
+    //! Storage of the router, built in place once the real functions exist.
+    //! g_router is published with release order after the real_* pointers
+    //! are set, and read with acquire order, so whoever sees the router
+    //! sees the real functions too.
+    alignas(PoolRouter) char g_router_area[sizeof(PoolRouter)];
+    std::atomic<PoolRouter *> g_router{ nullptr };
+    std::mutex g_lock;
+
+    //! Set while a thread is inside the pools, so that any allocation made
+    //! meanwhile (the router's own arenas, an exception) skips them.
+    __thread bool t_busy __attribute__((tls_model("initial-exec"))) = false;
+
+    //! Marks the calling thread as busy for the lifetime of the object.
+    struct BusyScope {
+        BusyScope( ) { t_busy = true; }
+        ~BusyScope( ) { t_busy = false; }
+    };
+
+    bool in_boot( const void *_p ) {
+        return _p >= static_cast<const void *>(g_boot) and
+               _p < static_cast<const void *>(g_boot + sizeof(g_boot));
+    }
+
+    //! Bump allocation from the bootstrap buffer, the size is kept before the area.
+    void *boot_alloc( size_type _b ) {
+        size_type need = (_b + Align - 1) / Align * Align + Align;
+        if ( g_boot_used + need > sizeof(g_boot) )
+            return nullptr;
+        char *area = g_boot + g_boot_used;
+        g_boot_used += need;
+        *reinterpret_cast<size_type *>(area) = _b;
+        return area + Align;
+    }
+
+    size_type boot_size( const void *_p ) {
+        return *reinterpret_cast<const size_type *>(static_cast<const char *>(_p) - Align);
+    }
+
+    size_type env_size( const char *_name, size_type _default ) {
+        const char *value = std::getenv(_name);
+        if ( value == nullptr or *value == '\0' )
+            return _default;
+        return std::strtoull(value, nullptr, 10);
+    }
+
+    void fork_prepare( ) { g_lock.lock( ); }
+    void fork_release( ) { g_lock.unlock( ); }
+
+    //! Finds the real functions and builds the router. Called with t_busy set.
+    void setup( ) {
+
+        std::lock_guard<std::mutex> guard(g_lock);
+        if ( g_router.load(std::memory_order_relaxed) != nullptr )
+            return;
+
+        real_malloc = reinterpret_cast<malloc_type>(dlsym(RTLD_NEXT, "malloc"));
+        real_free = reinterpret_cast<free_type>(dlsym(RTLD_NEXT, "free"));
+        real_calloc = reinterpret_cast<calloc_type>(dlsym(RTLD_NEXT, "calloc"));
+        real_realloc = reinterpret_cast<realloc_type>(dlsym(RTLD_NEXT, "realloc"));
+        real_memalign = reinterpret_cast<memalign_type>(dlsym(RTLD_NEXT, "posix_memalign"));
+        real_usable = reinterpret_cast<usable_type>(dlsym(RTLD_NEXT, "malloc_usable_size"));
+
+        // Huge sizes are left to the C library, which maps them anyway.
+        auto *router = new (g_router_area) PoolRouter( env_size("GREMLINS_SLOTS", 16384),
+                                                       env_size("GREMLINS_POOL_BYTES", 64u << 20),
+                                                       StoragePool::FIRST_FIT, false );
+        g_router.store(router, std::memory_order_release);
+
+        pthread_atfork(fork_prepare, fork_release, fork_release);
+    }
+
+    //! The router, built first when the calling thread may do it. Null only
+    //! while the router is being built.
+    PoolRouter *ready( ) {
+        PoolRouter *router = g_router.load(std::memory_order_acquire);
+        if ( router == nullptr and not t_busy ) {
+            BusyScope busy;
+            setup( );
+            router = g_router.load(std::memory_order_acquire);
+        }
+        return router;
+    }
+
+    //! Serves a request from the pools, or returns nullptr when they can not.
+    void *pool_alloc( PoolRouter *_router, size_type _b ) {
+
+        if ( _b >= PoolRouter::HugeSize )
+            return nullptr;
+
+        BusyScope busy;
+        std::lock_guard<std::mutex> guard(g_lock);
+        try {
+            void *p = _router->Allocate(_b);
+            // malloc and operator new promise alignof(std::max_align_t).
+            assert( reinterpret_cast<std::uintptr_t>(p) % Align == 0 );
+            return p;
+        }
+        catch ( std::bad_alloc & ) {
+            return nullptr;
+        }
+    }
+
+    void *gm_malloc( size_type _b ) {
+
+        if ( t_busy )
+            return real_malloc != nullptr ? real_malloc(_b) : boot_alloc(_b);
+
+        void *p = pool_alloc(ready( ), _b);
+        return p != nullptr ? p : real_malloc(_b);
+    }
+
+    void gm_free( void *_p ) {
+
+        if ( _p == nullptr or in_boot(_p) )
+            return;
+
+        // The arenas never move, so ownership is checked without the lock.
+        PoolRouter *router = ready( );
+        if ( router != nullptr and router->Owns(_p) ) {
+            BusyScope busy;
+            std::lock_guard<std::mutex> guard(g_lock);
+            router->Free(_p);
+            return;
+        }
+        real_free(_p);
+    }
+
+    size_type gm_usable( const void *_p ) {
+
+        if ( in_boot(_p) )
+            return boot_size(_p);
+        PoolRouter *router = ready( );
+        if ( router != nullptr and router->Owns(_p) )
+            return router->UsableSize(_p);
+        return real_usable(const_cast<void *>(_p));
+    }
+}
+
+/*------------------------------ C interface ------------------------------*/
+
+GM_EXPORT void *malloc( size_type _b ) {
+    return gm_malloc(_b);
+}
+
+GM_EXPORT void free( void *_p ) {
+    gm_free(_p);
+}
+
+GM_EXPORT void *calloc( size_type _n, size_type _b ) {
+
+    if ( _b != 0 and _n > size_type(-1) / _b ) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+
+    // The bootstrap buffer is zeroed and never reused.
+    if ( t_busy and real_calloc == nullptr )
+        return boot_alloc(_n * _b);
+
+    void *p = gm_malloc(_n * _b);
+    if ( p != nullptr )
+        std::memset(p, 0, _n * _b);
+    return p;
+}
+
+GM_EXPORT void *realloc( void *_p, size_type _b ) {
+
+    if ( _p == nullptr )
+        return gm_malloc(_b);
+    if ( _b == 0 ) {
+        gm_free(_p);
+        return nullptr;
+    }
+
+    PoolRouter *router = ready( );
+    bool ours = in_boot(_p) or ( router != nullptr and router->Owns(_p) );
+    if ( not ours )
+        return real_realloc(_p, _b);
+
+    size_type usable = gm_usable(_p);
+    if ( _b <= usable )
+        return _p;
+
+    void *q = gm_malloc(_b);
+    if ( q != nullptr ) {
+        std::memcpy(q, _p, usable);
+        gm_free(_p);
+    }
+    return q;
+}
+
+GM_EXPORT int posix_memalign( void **_out, size_type _align, size_type _b ) {
+
+    if ( _align % sizeof(void *) != 0 or ( _align & (_align - 1) ) != 0 )
+        return EINVAL;
+
+    // The router aligns every area it hands out (small slots, padded SLPool
+    // areas and mappings) to Align; larger alignments go to the C library.
+    if ( _align > Align ) {
+        ready( );
+        if ( real_memalign == nullptr )
+            return ENOMEM;
+        return real_memalign(_out, _align, _b);
+    }
+
+    void *p = gm_malloc(_b);
+    if ( p == nullptr )
+        return ENOMEM;
+    *_out = p;
+    return 0;
+}
+
+GM_EXPORT void *aligned_alloc( size_type _align, size_type _b ) {
+    void *p = nullptr;
+    int error = posix_memalign(&p, _align < sizeof(void *) ? sizeof(void *) : _align, _b);
+    if ( error != 0 ) {
+        errno = error;
+        return nullptr;
+    }
+    return p;
+}
+
+GM_EXPORT void *memalign( size_type _align, size_type _b ) {
+    return aligned_alloc(_align, _b);
+}
+
+GM_EXPORT size_type malloc_usable_size( void *_p ) {
+    return _p == nullptr ? 0 : gm_usable(_p);
+}
+
+/*----------------------------- C++ interface -----------------------------*/
+
+void *operator new( size_type _b ) {
+    void *p = gm_malloc(_b);
+    if ( p == nullptr )
+        throw(std::bad_alloc());
+    return p;
+}
+
+void *operator new[]( size_type _b ) {
+    return ::operator new(_b);
+}
+
+void *operator new( size_type _b, const std::nothrow_t & ) noexcept {
+    return gm_malloc(_b);
+}
+
+void *operator new[]( size_type _b, const std::nothrow_t & ) noexcept {
+    return gm_malloc(_b);
+}
+
+void operator delete( void *_p ) noexcept {
+    gm_free(_p);
+}
+
+void operator delete[]( void *_p ) noexcept {
+    gm_free(_p);
+}
+
+void operator delete( void *_p, size_type ) noexcept {
+    gm_free(_p);
+}
+
+void operator delete[]( void *_p, size_type ) noexcept {
+    gm_free(_p);
+}
+
+void operator delete( void *_p, const std::nothrow_t & ) noexcept {
+    gm_free(_p);
+}
+
+void operator delete[]( void *_p, const std::nothrow_t & ) noexcept {
+    gm_free(_p);
+}
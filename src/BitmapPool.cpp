@@ -0,0 +1,301 @@
+/**
+ * @file BitmapPool.cpp
+ * @version 1.0
+ * @since Jul, 02.
+ * @date Jul, 02.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::BitmapPool Class
+ */
+
+#include <iostream>
+
+#include <cstdint>  // To std::uint64_t, std::uintptr_t
+#include <string>   // To std::string
+#include <new>      // To std::bad_alloc
+#include "BitmapPool.hpp"
+
+#if defined(__GNUC__) and ( defined(__x86_64__) or defined(__i386__) )
+#define GM_X86 1
+#include <immintrin.h>  // To the SSE2 and AVX2 intrinsics
+#endif
+
+using namespace gm;
+
+typedef std::uint64_t word_type;
+
+namespace {
+
+    const word_type k_ones = ~word_type(0);
+
+    /*
+     * Word scanners: index of the first word in [_w, _end) that is not equal
+     * to the given pattern (0 when looking for free blocks, all ones when
+     * looking for used ones), or _end.
+     */
+
+    size_type skip_scalar( const word_type *_map, size_type _w, size_type _end, word_type _pattern ) {
+        while ( _w < _end and _map[_w] == _pattern )
+            _w++;
+        return _w;
+    }
+
+#if GM_X86 and defined(__SSE2__)
+    size_type skip_sse2( const word_type *_map, size_type _w, size_type _end, word_type _pattern ) {
+        const __m128i pattern = _mm_set1_epi64x(static_cast<long long>(_pattern));
+        for ( ; _w + 2 <= _end; _w += 2 ) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_map + _w));
+            if ( _mm_movemask_epi8(_mm_cmpeq_epi32(v, pattern)) != 0xFFFF )
+                break;
+        }
+        return skip_scalar(_map, _w, _end, _pattern);
+    }
+#endif
+
+#if GM_X86
+    __attribute__((target("avx2")))
+    size_type skip_avx2( const word_type *_map, size_type _w, size_type _end, word_type _pattern ) {
+        const __m256i pattern = _mm256_set1_epi64x(static_cast<long long>(_pattern));
+        for ( ; _w + 4 <= _end; _w += 4 ) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_map + _w));
+            if ( _mm256_movemask_epi8(_mm256_cmpeq_epi64(v, pattern)) != -1 )
+                break;
+        }
+        return skip_scalar(_map, _w, _end, _pattern);
+    }
+#endif
+
+    typedef size_type (*skip_type)( const word_type *, size_type, size_type, word_type );
+
+    //! Picks the widest scanner the machine runs.
+    skip_type pick_skip( const char **_name ) {
+#if GM_X86
+        __builtin_cpu_init( );
+        if ( __builtin_cpu_supports("avx2") ) {
+            *_name = "avx2";
+            return skip_avx2;
+        }
+#endif
+#if GM_X86 and defined(__SSE2__)
+        *_name = "sse2";
+        return skip_sse2;
+#else
+        *_name = "scalar";
+        return skip_scalar;
+#endif
+    }
+
+    const char *g_engine = "scalar";
+    const skip_type g_skip = pick_skip(&g_engine);
+
+    //! Mask with the bits [_from, _from + _n) of a word set.
+    word_type bits( size_type _from, size_type _n ) {
+        word_type high = _n == BitmapPool::WordBits ? k_ones : ((word_type(1) << _n) - 1);
+        return high << _from;
+    }
+}
+
+/**
+ * @brief gm::BitmapPool class implementation.
+ */
+
+BitmapPool::BitmapPool( size_type _b, StoragePool::policy_type _pt ) :
+    m_n_blocks( (_b + BlockSize - 1) / BlockSize ),
+    m_n_words( (m_n_blocks + WordBits - 1) / WordBits ),
+    m_raw( new char[m_n_blocks * BlockSize + BlockSize] ),
+    m_begin( nullptr ),
+    m_map( new word_type[m_n_words] ),
+    m_ends( new word_type[m_n_words] ),
+    m_hint( 0 ) {
+
+        // new[] only promises the alignment of a pointer, so align by hand.
+        auto addr = reinterpret_cast<std::uintptr_t>(m_raw);
+        m_begin = m_raw + (BlockSize - addr % BlockSize) % BlockSize;
+
+        // Every block starts free; the bits past the last block stay used,
+        // so no run goes beyond the arena.
+        for ( size_type w = 0; w < m_n_words; w++ ) {
+            m_map[w] = k_ones;
+            m_ends[w] = 0;
+        }
+        if ( m_n_blocks % WordBits != 0 )
+            m_map[m_n_words - 1] = bits(0, m_n_blocks % WordBits);
+
+        StoragePool::m_policy = _pt;
+}
+
+BitmapPool::~BitmapPool( ) {
+    delete[] m_ends;
+    delete[] m_map;
+    delete[] m_raw;
+}
+
+const char *BitmapPool::Engine( ) {
+    return g_engine;
+}
+
+size_type BitmapPool::NextFree( size_type _pos ) const {
+
+    size_type w = _pos / WordBits;
+    if ( w >= m_n_words )
+        return m_n_blocks;
+
+    // Free blocks of the first word, at or after _pos.
+    word_type word = m_map[w] & (k_ones << (_pos % WordBits));
+    if ( word == 0 ) {
+        w = g_skip(m_map, w + 1, m_n_words, 0);
+        if ( w == m_n_words )
+            return m_n_blocks;
+        word = m_map[w];
+    }
+    return w * WordBits + __builtin_ctzll(word);
+}
+
+size_type BitmapPool::NextUsed( size_type _pos ) const {
+
+    size_type w = _pos / WordBits;
+    if ( w >= m_n_words )
+        return m_n_blocks;
+
+    // Used blocks of the first word, at or after _pos.
+    word_type word = ~m_map[w] & (k_ones << (_pos % WordBits));
+    if ( word == 0 ) {
+        w = g_skip(m_map, w + 1, m_n_words, k_ones);
+        if ( w == m_n_words )
+            return m_n_blocks;
+        word = ~m_map[w];
+    }
+    size_type pos = w * WordBits + __builtin_ctzll(word);
+    return pos < m_n_blocks ? pos : m_n_blocks;
+}
+
+size_type BitmapPool::AreaEnd( size_type _pos ) const {
+
+    // Ends of the first word, at or after _pos; an area always has one.
+    size_type w = _pos / WordBits;
+    word_type word = m_ends[w] & (k_ones << (_pos % WordBits));
+    if ( word == 0 ) {
+        w = g_skip(m_ends, w + 1, m_n_words, 0);
+        word = m_ends[w];
+    }
+    return w * WordBits + __builtin_ctzll(word);
+}
+
+void BitmapPool::Mark( size_type _pos, size_type _n, bool _free ) {
+
+    while ( _n > 0 ) {
+        size_type w = _pos / WordBits, from = _pos % WordBits;
+        size_type count = WordBits - from < _n ? WordBits - from : _n;
+        if ( _free )
+            m_map[w] |= bits(from, count);
+        else
+            m_map[w] &= ~bits(from, count);
+        _pos += count;
+        _n -= count;
+    }
+}
+
+void *BitmapPool::Take( size_type _pos, size_type _n ) {
+    Mark(_pos, _n, false);
+    size_type last = _pos + _n - 1;
+    m_ends[last / WordBits] |= word_type(1) << (last % WordBits);
+    return m_begin + _pos * BlockSize;
+}
+
+void *BitmapPool::Allocate( size_type _b ) {
+
+    size_type n_blocks = _b == 0 ? 1 : (_b + BlockSize - 1) / BlockSize;
+
+    // Nothing is free before the first word with a free block.
+    size_type w = m_hint = g_skip(m_map, m_hint, m_n_words, 0);
+    size_type carry = 0;    // Free blocks at the top of the previous words.
+
+    while ( w < m_n_words ) {
+        word_type word = m_map[w];
+
+        if ( word == 0 and carry == 0 ) {
+            w = g_skip(m_map, w + 1, m_n_words, 0);
+            continue;
+        }
+
+        if ( word == k_ones ) {
+            carry += WordBits;
+            if ( carry >= n_blocks )
+                return Take((w + 1) * WordBits - carry, n_blocks);
+            w++;
+            continue;
+        }
+
+        // A run that started in the previous words and ends in this one.
+        if ( carry + __builtin_ctzll(~word) >= n_blocks )
+            return Take(w * WordBits - carry, n_blocks);
+
+        // A run inside this word (it needs at least n_blocks free bits): after
+        // the shifts, a bit is still set only if it starts n_blocks free blocks.
+        if ( n_blocks <= WordBits and
+             static_cast<size_type>(__builtin_popcountll(word)) >= n_blocks ) {
+            word_type starts = word;
+            for ( size_type length = 1; length < n_blocks and starts != 0; ) {
+                size_type shift = length < n_blocks - length ? length : n_blocks - length;
+                starts &= starts >> shift;
+                length += shift;
+            }
+            if ( starts != 0 )
+                return Take(w * WordBits + __builtin_ctzll(starts), n_blocks);
+        }
+
+        carry = __builtin_clzll(~word);
+        w++;
+    }
+
+    throw(std::bad_alloc());
+}
+
+void *BitmapPool::AllocateBF( size_type _b ) {
+
+    size_type n_blocks = _b == 0 ? 1 : (_b + BlockSize - 1) / BlockSize;
+    size_type best = m_n_blocks, best_length = 0;
+
+    size_type pos = NextFree(m_hint * WordBits);
+    m_hint = pos / WordBits;
+
+    while ( pos < m_n_blocks ) {
+        size_type end = NextUsed(pos);
+        size_type length = end - pos;
+        if ( length == n_blocks )
+            return Take(pos, n_blocks);
+        if ( length > n_blocks and ( best == m_n_blocks or length < best_length ) ) {
+            best = pos;
+            best_length = length;
+        }
+        pos = NextFree(end);
+    }
+
+    if ( best != m_n_blocks )
+        return Take(best, n_blocks);
+
+    throw(std::bad_alloc());
+}
+
+void BitmapPool::Free( void *_p ) {
+
+    size_type pos = (reinterpret_cast<char *>(_p) - m_begin) / BlockSize;
+    size_type last = AreaEnd(pos);
+    m_ends[last / WordBits] &= ~(word_type(1) << (last % WordBits));
+    Mark(pos, last - pos + 1, true);
+    if ( pos / WordBits < m_hint )
+        m_hint = pos / WordBits;
+}
+
+void BitmapPool::view( ) {
+
+    std::string buffer;
+    for ( size_type pos = 0; pos < m_n_blocks; ) {
+        bool is_free = m_map[pos / WordBits] >> (pos % WordBits) & 1;
+        size_type end = is_free ? NextUsed(pos) : AreaEnd(pos) + 1;
+        std::cout << "[ " << std::string(end - pos, is_free ? '+' : '#') << " ] ";
+        buffer += (is_free ? "+[" : "-[") + std::to_string(end - pos) + "] ";
+        pos = end;
+    }
+    std::cout << "\n" << buffer << "|| Total blocks: " << m_n_blocks << "\n";
+}
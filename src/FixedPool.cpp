@@ -0,0 +1,82 @@
+/**
+ * @file FixedPool.cpp
+ * @version 1.0
+ * @since Jun, 28.
+ * @date Jun, 28.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::FixedPool Class
+ */
+
+#include <iostream>
+
+#include <cstdint>  // To std::uintptr_t
+#include <string>   // To std::string
+#include <new>      // To std::bad_alloc
+#include "FixedPool.hpp"
+
+using namespace gm;
+
+/**
+ * @brief gm::FixedPool class implementation.
+ */
+
+FixedPool::FixedPool( size_type _slot, size_type _n ) :
+    m_slot( (_slot + Align - 1) / Align * Align ),
+    m_n_slots( _n ),
+    m_raw( new char[m_slot * m_n_slots + Align] ),
+    m_begin( nullptr ),
+    m_end( nullptr ),
+    m_free( nullptr ) {
+
+        // new[] only promises the alignment of a pointer, so align by hand.
+        auto addr = reinterpret_cast<std::uintptr_t>(m_raw);
+        m_begin = m_raw + (Align - addr % Align) % Align;
+        m_end = m_begin + m_slot * m_n_slots;
+
+        // Chains every slot, from the last to the first one.
+        for ( char *pos = m_end; pos != m_begin; ) {
+            pos -= m_slot;
+            auto *slot = reinterpret_cast<Slot *>(pos);
+            slot->m_next = m_free;
+            m_free = slot;
+        }
+
+        StoragePool::m_policy = StoragePool::FIRST_FIT;
+}
+
+FixedPool::~FixedPool( ) {
+    delete[] m_raw;
+}
+
+void *FixedPool::Allocate( size_type _b ) {
+
+    if ( _b > m_slot or m_free == nullptr )
+        throw(std::bad_alloc());
+
+    Slot *slot = m_free;
+    m_free = slot->m_next;
+    return reinterpret_cast<void *>(slot);
+}
+
+void *FixedPool::AllocateBF( size_type _b ) {
+    return Allocate(_b);
+}
+
+void FixedPool::Free( void *_p ) {
+
+    auto *slot = reinterpret_cast<Slot *>(_p);
+    slot->m_next = m_free;
+    m_free = slot;
+}
+
+void FixedPool::view( ) {
+
+    // Marks the free slots first, then prints the whole arena in order.
+    std::string map(m_n_slots, '#');
+    for ( Slot *pos = m_free; pos != nullptr; pos = pos->m_next )
+        map[(reinterpret_cast<char *>(pos) - m_begin) / m_slot] = '+';
+
+    std::cout << "[ " << map << " ] || Slot size: " << m_slot
+              << " Total slots: " << m_n_slots << "\n";
+}
@@ -0,0 +1,89 @@
+/**
+ * @file FramePool.cpp
+ * @version 1.0
+ * @since Jul, 03.
+ * @date Jul, 03.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::FramePool Class
+ */
+
+#include <iostream>
+
+#include <new>      // To std::bad_alloc, ::operator new
+#include "FramePool.hpp"
+
+using namespace gm;
+
+/**
+ * @brief gm::FramePool class implementation.
+ */
+
+FramePool::FramePool( size_type _b ) :
+    m_pool( _b ),
+    m_pad( 0 ) {
+
+        for ( int i = 0; i < Lists; i++ )
+            m_free[i] = nullptr;
+
+        m_pad = m_pool.AlignPad(Align);
+
+        StoragePool::m_policy = StoragePool::FIRST_FIT;
+}
+
+FramePool &FramePool::Local( ) {
+    thread_local FramePool pool;
+    return pool;
+}
+
+size_type FramePool::BlocksOf( size_type _b ) const {
+    // Same block count SLPool would use, so the list matches the Header.
+    return (Room(_b) + m_pad + sizeof(SLPool::Header) + SLPool::Block::BlockSize - 1)
+           / SLPool::Block::BlockSize;
+}
+
+void *FramePool::Allocate( size_type _b ) {
+
+    size_type n_blocks = BlocksOf(_b);
+
+    if ( n_blocks <= Lists and m_free[n_blocks - 1] != nullptr ) {
+        Frame *frame = m_free[n_blocks - 1];
+        m_free[n_blocks - 1] = frame->m_next;
+        return frame;
+    }
+
+    try {
+        return reinterpret_cast<char *>(m_pool.Allocate(Room(_b) + m_pad)) + m_pad;
+    }
+    catch ( std::bad_alloc & ) {
+        return ::operator new(_b);
+    }
+}
+
+void *FramePool::AllocateBF( size_type _b ) {
+    return Allocate(_b);
+}
+
+void FramePool::Free( void *_p ) {
+
+    if ( not m_pool.Owns(_p) ) {
+        ::operator delete(_p);
+        return;
+    }
+
+    char *area = reinterpret_cast<char *>(_p) - m_pad;
+    size_type n_blocks = (m_pool.UsableSize(area) + sizeof(SLPool::Header))
+                         / SLPool::Block::BlockSize;
+    if ( n_blocks > Lists ) {
+        m_pool.Free(area);
+        return;
+    }
+
+    auto *frame = reinterpret_cast<Frame *>(_p);
+    frame->m_next = m_free[n_blocks - 1];
+    m_free[n_blocks - 1] = frame;
+}
+
+void FramePool::view( ) {
+    m_pool.view( );
+}
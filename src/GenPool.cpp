@@ -0,0 +1,169 @@
+/**
+ * @file GenPool.cpp
+ * @version 1.0
+ * @since Jul, 04.
+ * @date Jul, 04.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::GenPool Class
+ */
+
+#include <iostream>
+
+#include <cstdint>  // To std::uintptr_t
+#include <new>      // To std::bad_alloc
+#include "GenPool.hpp"
+
+using namespace gm;
+
+/**
+ * @brief gm::GenPool class implementation.
+ */
+
+GenPool::GenPool( size_type _short, size_type _long, bool _predict, size_type _limit ) :
+    m_region_size( _short / Regions / Align * Align ),
+    m_raw( new char[m_region_size * Regions + Align] ),
+    m_current( 0 ),
+    m_long( _long ),
+    m_pad( 0 ),
+    m_predict( _predict ),
+    m_limit( _limit ),
+    m_clock( 0 ),
+    m_resets( 0 ) {
+
+        // new[] only promises the alignment of a pointer, so align by hand.
+        auto addr = reinterpret_cast<std::uintptr_t>(m_raw);
+        char *begin = m_raw + (Align - addr % Align) % Align;
+
+        for ( int i = 0; i < Regions; i++ ) {
+            m_regions[i].m_begin = begin + i * m_region_size;
+            m_regions[i].m_used = 0;
+            m_regions[i].m_live = 0;
+        }
+
+        m_pad = m_long.AlignPad(Align);
+
+        // A negative average means no area of that class was freed yet.
+        for ( int i = 0; i < Classes; i++ )
+            m_lifetime[i] = -1;
+
+        StoragePool::m_policy = StoragePool::FIRST_FIT;
+}
+
+GenPool::~GenPool( ) {
+    delete[] m_raw;
+}
+
+std::uint32_t GenPool::ClassOf( size_type _b ) {
+    std::uint32_t c = 0;
+    while ( _b > 1 and c + 1 < Classes ) {
+        _b >>= 1;
+        c++;
+    }
+    return c;
+}
+
+StoragePool::lifetime_type GenPool::Predict( size_type _b ) const {
+    double seen = m_lifetime[ClassOf(_b)];
+    return seen >= 0 and seen < m_limit ? SHORT_LIVED : LONG_LIVED;
+}
+
+GenPool::Header *GenPool::BumpShort( size_type _need ) {
+
+    Region *region = &m_regions[m_current];
+    if ( region->m_used + _need > m_region_size ) {
+        // Moves on to a region that has emptied, if there is one.
+        region = nullptr;
+        for ( int i = 0; i < Regions; i++ ) {
+            if ( m_regions[i].m_live == 0 and _need <= m_region_size ) {
+                m_current = i;
+                region = &m_regions[i];
+                break;
+            }
+        }
+        if ( region == nullptr )
+            return nullptr;
+    }
+
+    auto *head = reinterpret_cast<Header *>(region->m_begin + region->m_used);
+    region->m_used += _need;
+    region->m_live++;
+    head->m_region = static_cast<std::uint32_t>(m_current);
+    return head;
+}
+
+void *GenPool::Allocate( size_type _b ) {
+    return Place(_b, UNKNOWN_LIFETIME, false);
+}
+
+void *GenPool::AllocateBF( size_type _b ) {
+    return Place(_b, UNKNOWN_LIFETIME, true);
+}
+
+void *GenPool::AllocateHinted( size_type _b, lifetime_type _lt ) {
+    return Place(_b, _lt, m_policy == BEST_FIT);
+}
+
+void *GenPool::Place( size_type _b, lifetime_type _lt, bool _best ) {
+
+    if ( _lt == UNKNOWN_LIFETIME )
+        _lt = m_predict ? Predict(_b) : LONG_LIVED;
+
+    Header *head = nullptr;
+    if ( _lt == SHORT_LIVED )
+        head = BumpShort( (sizeof(Header) + _b + Align - 1) / Align * Align );
+
+    // Long-lived, or every region is still busy.
+    if ( head == nullptr ) {
+        size_type need = m_pad + sizeof(Header) + _b;
+        char *area = reinterpret_cast<char *>( _best ? m_long.AllocateBF(need) : m_long.Allocate(need) );
+        head = reinterpret_cast<Header *>(area + m_pad);
+        head->m_region = LongRegion;
+    }
+
+    head->m_class = ClassOf(_b);
+    head->m_birth = m_clock++;
+    return reinterpret_cast<void *>(head + 1U);
+}
+
+void GenPool::Free( void *_p ) {
+
+    Header *head = reinterpret_cast<Header *>(_p) - 1U;
+
+    // Teaches the predictor how long this size class lives.
+    double lifetime = static_cast<double>(m_clock - head->m_birth);
+    double &seen = m_lifetime[head->m_class];
+    seen = seen < 0 ? lifetime : seen + (lifetime - seen) / 8;
+
+    if ( head->m_region == LongRegion ) {
+        m_long.Free(reinterpret_cast<char *>(head) - m_pad);
+        return;
+    }
+
+    // The last area of a region is gone: the whole region is free again.
+    Region &region = m_regions[head->m_region];
+    if ( --region.m_live == 0 ) {
+        region.m_used = 0;
+        m_resets++;
+    }
+}
+
+void GenPool::FreeStats( size_type &_free, size_type &_largest ) const {
+
+    m_long.FreeStats(_free, _largest);
+    for ( int i = 0; i < Regions; i++ ) {
+        size_type room = m_region_size - m_regions[i].m_used;
+        _free += room;
+        if ( room > _largest )
+            _largest = room;
+    }
+}
+
+void GenPool::view( ) {
+
+    for ( int i = 0; i < Regions; i++ )
+        std::cout << "[ Region " << i << ": " << m_regions[i].m_used << "/" << m_region_size
+                  << " bytes, " << m_regions[i].m_live << " live ] ";
+    std::cout << "|| Resets: " << m_resets << "\n";
+    m_long.view( );
+}
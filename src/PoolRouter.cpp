@@ -0,0 +1,150 @@
+/**
+ * @file PoolRouter.cpp
+ * @version 1.0
+ * @since Jun, 28.
+ * @date Jun, 28.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::PoolRouter Class
+ */
+
+#include <iostream>
+
+#include <new>          // To std::bad_alloc
+#include <sys/mman.h>   // To mmap, munmap
+#include "PoolRouter.hpp"
+
+using namespace gm;
+
+namespace {
+
+    //! Size of each small class, indexed by class.
+    constexpr size_type k_class_size[PoolRouter::NumClasses] = { 16, 32, 64, 128, 256 };
+
+    //! Small class of a request, indexed by its size in 16 byte units, rounded up.
+    constexpr unsigned char k_class_of[PoolRouter::MaxSmall / 16 + 1] = {
+        0, 0,                           // 0, 16
+        1,                              // 32
+        2, 2,                           // 48, 64
+        3, 3, 3, 3,                     // 80 .. 128
+        4, 4, 4, 4, 4, 4, 4, 4          // 144 .. 256
+    };
+
+    static_assert( k_class_size[k_class_of[PoolRouter::MaxSmall / 16]] == PoolRouter::MaxSmall,
+                   "the largest small class must hold MaxSmall bytes" );
+}
+
+/**
+ * @brief gm::PoolRouter class implementation.
+ */
+
+PoolRouter::PoolRouter( size_type _slots, size_type _b,
+                        StoragePool::policy_type _pt, bool _map_huge ) :
+    m_medium( _b, _pt ),
+    m_pad( 0 ),
+    m_map_huge( _map_huge ) {
+
+        for ( int i = 0; i < NumClasses; i++ )
+            m_small[i] = new FixedPool( k_class_size[i], _slots );
+
+        m_pad = m_medium.AlignPad(Align);
+
+        StoragePool::m_policy = _pt;
+}
+
+PoolRouter::~PoolRouter( ) {
+    for ( int i = 0; i < NumClasses; i++ )
+        delete m_small[i];
+}
+
+void *PoolRouter::Allocate( size_type _b ) {
+    return Route(_b, false);
+}
+
+void *PoolRouter::AllocateBF( size_type _b ) {
+    return Route(_b, true);
+}
+
+void *PoolRouter::Route( size_type _b, bool _best ) {
+
+    if ( _b <= MaxSmall ) {
+        try {
+            return m_small[k_class_of[(_b + 15) / 16]]->Allocate(_b);
+        }
+        catch ( std::bad_alloc & ) { /* Class is full, spill to the SLPool. */ }
+    }
+
+    if ( _b < HugeSize ) {
+        try {
+            char *pos = reinterpret_cast<char *>(
+                _best ? m_medium.AllocateBF(_b + m_pad) : m_medium.Allocate(_b + m_pad) );
+            return pos + m_pad;
+        }
+        catch ( std::bad_alloc & ) { /* SLPool is full, spill to the OS. */ }
+    }
+
+    return MapHuge(_b);
+}
+
+void *PoolRouter::MapHuge( size_type _b ) {
+
+    if ( not m_map_huge )
+        throw(std::bad_alloc());
+
+    // The mapping length is kept right before the client's area.
+    size_type length = _b + Align;
+    void *area = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ( area == MAP_FAILED )
+        throw(std::bad_alloc());
+
+    *reinterpret_cast<size_type *>(area) = length;
+    return reinterpret_cast<char *>(area) + Align;
+}
+
+void PoolRouter::Free( void *_p ) {
+
+    for ( int i = 0; i < NumClasses; i++ ) {
+        if ( m_small[i]->Owns(_p) ) {
+            m_small[i]->Free(_p);
+            return;
+        }
+    }
+
+    if ( m_medium.Owns(_p) ) {
+        m_medium.Free(reinterpret_cast<char *>(_p) - m_pad);
+        return;
+    }
+
+    // Not in any arena, so it was mapped by MapHuge.
+    char *area = reinterpret_cast<char *>(_p) - Align;
+    munmap(area, *reinterpret_cast<size_type *>(area));
+}
+
+bool PoolRouter::Owns( const void *_p ) const {
+
+    for ( int i = 0; i < NumClasses; i++ )
+        if ( m_small[i]->Owns(_p) )
+            return true;
+    return m_medium.Owns(_p);
+}
+
+size_type PoolRouter::UsableSize( const void *_p ) const {
+
+    for ( int i = 0; i < NumClasses; i++ )
+        if ( m_small[i]->Owns(_p) )
+            return m_small[i]->SlotSize( );
+
+    if ( m_medium.Owns(_p) )
+        return m_medium.UsableSize(reinterpret_cast<const char *>(_p) - m_pad) - m_pad;
+
+    auto *area = reinterpret_cast<const char *>(_p) - Align;
+    return *reinterpret_cast<const size_type *>(area) - Align;
+}
+
+void PoolRouter::view( ) {
+
+    for ( int i = 0; i < NumClasses; i++ )
+        m_small[i]->view( );
+    m_medium.view( );
+}
@@ -10,11 +10,15 @@
 
 #include <iostream>
 
+#include <cassert>  // To assert
 #include <cmath>    // To std::ceil
+#include <cstdint>  // To std::uintptr_t
 #include <cstdio>   // To std::size_t
+#include <cstring>  // To std::memcpy
 #include <string>   // To std::string
 #include <new>      // To std::bad_alloc
 #include "SLPool.hpp"
+#include "heap_map.hpp"
 
 using namespace gm;
 
@@ -26,10 +30,12 @@ typedef std::string string;
  * @brief gm::SLPool class implementation.
  */
 
-SLPool::SLPool( size_type _b, StoragePool::policy_type _pt ) :
-    m_n_blocks( std::ceil( static_cast<float>( _b)/Block::BlockSize ) + 1 ),
+SLPool::SLPool( size_type _b, StoragePool::policy_type _pt, coalesce_type _ct ) :
+    m_n_blocks( std::ceil( static_cast<float>( _b)/static_cast<float>(Block::BlockSize) ) + 1 ),
     m_pool( new Block[m_n_blocks] ),
-    m_sentinel( m_pool[m_n_blocks - 1] ) {
+    m_sentinel( m_pool[m_n_blocks - 1] ),
+    m_coalesce( _ct ),
+    m_n_quick( 0 ) {
     
     	// Sets the first m_pool element values.
     	m_pool[0].m_length = m_n_blocks - 1;
@@ -40,6 +46,9 @@ SLPool::SLPool( size_type _b, StoragePool::policy_type _pt ) :
 
 		// Defines policy type.
 		StoragePool::m_policy = _pt;
+
+		for ( int i = 0; i < QuickLists; i++ )
+			m_quick[i] = nullptr;
 }
 
 SLPool::~SLPool() {
@@ -48,7 +57,14 @@ SLPool::~SLPool() {
 
 void *SLPool::Allocate(size_type _b) {
     
-    unsigned n_blocks = std::ceil(static_cast<float>(_b)/Block::BlockSize);
+    // The Header lives inside the first block, so it counts towards the size.
+    unsigned n_blocks = std::ceil(static_cast<float>(_b + sizeof(Header))/static_cast<float>(Block::BlockSize));
+
+    // A quick-listed area of the very same size needs no search nor split.
+    Block *quick = QuickPop(n_blocks);
+    if ( quick != nullptr )
+        return reinterpret_cast<void *>(reinterpret_cast<Header *>(quick)+1U);
+
     Block *pos = m_sentinel.m_next;
     Block *prev_pos = &m_sentinel;
 
@@ -71,12 +87,25 @@ void *SLPool::Allocate(size_type _b) {
         pos = pos->m_next;
     }
 
+    // Merging the quick-listed areas may make room.
+    if ( m_n_quick > 0 ) {
+        Consolidate( );
+        return Allocate(_b);
+    }
+
     throw(std::bad_alloc());
 }
 
 void *SLPool::AllocateBF(size_type _b) {
     
-    unsigned n_blocks = std::ceil(static_cast< float >(_b)/Block::BlockSize);
+    // The Header lives inside the first block, so it counts towards the size.
+    unsigned n_blocks = std::ceil(static_cast< float >(_b + sizeof(Header))/static_cast<float>(Block::BlockSize));
+
+    // A quick-listed area of the very same size needs no search nor split.
+    Block *quick = QuickPop(n_blocks);
+    if ( quick != nullptr )
+        return reinterpret_cast<void *>(reinterpret_cast<Header *>(quick)+1U);
+
     Block *pos = m_sentinel.m_next;
     Block *prev_pos = &m_sentinel;
     Block *prev_best = nullptr;
@@ -112,12 +141,28 @@ void *SLPool::AllocateBF(size_type _b) {
         return reinterpret_cast<void *>(reinterpret_cast<Header *>(best)+1U);
     }
 
+    // Merging the quick-listed areas may make room.
+    if ( m_n_quick > 0 ) {
+        Consolidate( );
+        return AllocateBF(_b);
+    }
+
     throw(std::bad_alloc());
 }
 
 void SLPool::Free(void *_p) {
     
     auto *BEGIN = reinterpret_cast<Block *>(reinterpret_cast<Header *>(_p)-1U);
+
+    // Deferred mode: small areas wait on their quick list, unmerged.
+    if ( m_coalesce == DEFERRED and BEGIN->m_length <= QuickLists ) {
+        BEGIN->m_next = m_quick[BEGIN->m_length - 1];
+        m_quick[BEGIN->m_length - 1] = BEGIN;
+        if ( ++m_n_quick > QuickThreshold )
+            Consolidate( );
+        return;
+    }
+
     auto *pos = m_sentinel.m_next;
     auto *p_pos = &m_sentinel;
 
@@ -159,7 +204,172 @@ void SLPool::Free(void *_p) {
     }
 }
 
+bool SLPool::Owns( const void *_p ) const {
+    // The sentinel is never handed out, so it is not part of the arena.
+    return _p >= static_cast<const void *>(m_pool) and
+           _p < static_cast<const void *>(&m_sentinel);
+}
+
+size_type SLPool::UsableSize( const void *_p ) const {
+    auto *head = reinterpret_cast<const Header *>(_p) - 1U;
+    return head->m_length * Block::BlockSize - sizeof(Header);
+}
+
+size_type SLPool::AlignPad( size_type _align ) const {
+
+    assert( Block::BlockSize % _align == 0 );
+    auto addr = reinterpret_cast<std::uintptr_t>(m_pool) + sizeof(Header);
+    return (_align - addr % _align) % _align;
+}
+
+void SLPool::FreeStats( size_type &_free, size_type &_largest ) const {
+
+    _free = _largest = 0;
+    for ( Block *pos = m_sentinel.m_next; pos != nullptr; pos = pos->m_next ) {
+        _free += pos->m_length;
+        if ( pos->m_length > _largest )
+            _largest = pos->m_length;
+    }
+    for ( int i = 0; i < QuickLists; i++ )
+        for ( Block *pos = m_quick[i]; pos != nullptr; pos = pos->m_next )
+            _free += pos->m_length;
+
+    _free *= Block::BlockSize;
+    _largest *= Block::BlockSize;
+}
+
+SLPool::Block *SLPool::QuickPop( uint _n ) {
+
+    if ( m_coalesce != DEFERRED or _n > QuickLists or m_quick[_n - 1] == nullptr )
+        return nullptr;
+
+    Block *block = m_quick[_n - 1];
+    m_quick[_n - 1] = block->m_next;
+    m_n_quick--;
+    return block;
+}
+
+SLPool::Block *SLPool::SortByAddress( Block *_list ) {
+
+    if ( _list == nullptr or _list->m_next == nullptr )
+        return _list;
+
+    // Splits the list in halves, sorts each and merges them back.
+    Block *slow = _list, *fast = _list->m_next;
+    while ( fast != nullptr and fast->m_next != nullptr ) {
+        slow = slow->m_next;
+        fast = fast->m_next->m_next;
+    }
+    Block *second = SortByAddress(slow->m_next);
+    slow->m_next = nullptr;
+    Block *first = SortByAddress(_list);
+
+    Block head;
+    Block *tail = &head;
+    while ( first != nullptr and second != nullptr ) {
+        Block *&smaller = first < second ? first : second;
+        tail->m_next = smaller;
+        tail = smaller;
+        smaller = smaller->m_next;
+    }
+    tail->m_next = first != nullptr ? first : second;
+    return head.m_next;
+}
+
+void SLPool::Consolidate( ) {
+
+    if ( m_n_quick == 0 )
+        return;
+
+    // Gathers every quick list into one list, sorted by address.
+    Block *pending = nullptr;
+    for ( int i = 0; i < QuickLists; i++ ) {
+        while ( m_quick[i] != nullptr ) {
+            Block *block = m_quick[i];
+            m_quick[i] = block->m_next;
+            block->m_next = pending;
+            pending = block;
+        }
+    }
+    m_n_quick = 0;
+    pending = SortByAddress(pending);
+
+    // Both lists are sorted, so a single pass inserts and merges them all.
+    Block *p_pos = &m_sentinel;
+    Block *pos = m_sentinel.m_next;
+    while ( pending != nullptr ) {
+        Block *BEGIN = pending;
+        pending = pending->m_next;
+
+        while ( pos != nullptr and pos < BEGIN ) {
+            p_pos = pos;
+            pos = pos->m_next;
+        }
+
+        if ( p_pos != &m_sentinel and p_pos + p_pos->m_length == BEGIN ) {
+            p_pos->m_length += BEGIN->m_length;
+            BEGIN->m_length = 0;
+            BEGIN = p_pos;
+        } else {
+            p_pos->m_next = BEGIN;
+            BEGIN->m_next = pos;
+        }
+
+        if ( pos != nullptr and BEGIN + BEGIN->m_length == pos ) {
+            BEGIN->m_length += pos->m_length;
+            pos->m_length = 0;
+            BEGIN->m_next = pos->m_next;
+            pos = BEGIN->m_next;
+        }
+        p_pos = BEGIN;
+    }
+}
+
+size_type SLPool::snapshot( void *_buf, size_type _len ) {
+
+	// Quick-listed areas are free, so they are merged before being mapped.
+	Consolidate( );
+
+	auto *out = static_cast<char *>(_buf);
+	size_type size = sizeof(HeapMapHeader);
+	std::uint32_t records = 0;
+
+	// The free list is sorted, so it is followed along with the arena.
+	auto *pt = m_sentinel.m_next;
+	for ( uint pos = 0; pos < m_n_blocks - 1; pos += m_pool[pos].m_length ) {
+
+		HeapMapRecord record;
+		record.m_offset = pos;
+		record.m_length = m_pool[pos].m_length;
+		if ( m_pool + pos == pt ) {
+			record.m_length |= HeapMapRecord::FreeBit;
+			pt = pt->m_next;
+		}
+
+		// _buf may have any alignment.
+		if ( size + sizeof(record) <= _len ) {
+			std::memcpy(out + size, &record, sizeof(record));
+			records++;
+		}
+		size += sizeof(record);
+	}
+
+	if ( sizeof(HeapMapHeader) <= _len ) {
+		HeapMapHeader header;
+		header.m_magic = HeapMapMagic;
+		header.m_version = HeapMapVersion;
+		header.m_block_size = sizeof(Block);	// The stride of the arena.
+		header.m_blocks = m_n_blocks - 1;
+		header.m_records = records;
+		std::memcpy(out, &header, sizeof(header));
+	}
+	return size;
+}
+
 void SLPool::view( ) {
+
+	// Quick-listed areas are free, so they are merged before being shown.
+	Consolidate( );
 	
 	auto *pt = m_sentinel.m_next;
 	auto pos = 0u;
@@ -0,0 +1,222 @@
+/**
+ * @file heap_profiler.cpp
+ * @version 1.0
+ * @since Jul, 01.
+ * @date Jul, 01.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::HeapProfiler Class
+ */
+
+#include <iostream>
+
+#include <algorithm>    // To std::reverse
+#include <atomic>       // To std::atomic
+#include <cmath>        // To std::log, std::exp
+#include <cstdio>       // To std::snprintf
+#include <cstdlib>      // To std::free
+#include <fstream>      // To std::ifstream
+#include <map>          // To std::map
+#include <mutex>        // To std::mutex
+#include <random>       // To std::mt19937_64
+#include <string>       // To std::string
+#include <unordered_map>// To std::unordered_map
+#include <utility>      // To std::pair
+#include <vector>       // To std::vector
+#include <cxxabi.h>     // To abi::__cxa_demangle
+#include <dlfcn.h>      // To dladdr
+#include <execinfo.h>   // To backtrace
+#include "heap_profiler.hpp"
+
+using namespace gm;
+
+/**
+ * @brief gm::HeapProfiler class implementation.
+ */
+
+namespace {
+
+    enum {
+        MaxFrames = 32,             // Deepest backtrace kept.
+        SkipFrames = 1,             // Sample itself.
+        OffCountdown = 1 << 20      // Bytes between checks while sampling is off.
+    };
+
+    typedef std::vector<void *> Stack;
+
+    //! Sampled objects that share a pool and a backtrace.
+    struct Bucket {
+        size_type inuse_objs = 0;
+        size_type inuse_bytes = 0;
+        size_type alloc_objs = 0;
+        size_type alloc_bytes = 0;
+    };
+
+    typedef std::map< std::pair<StoragePool *, Stack>, Bucket > bucket_map;
+
+    //! A live sampled object.
+    struct Live {
+        size_type bytes;            //!< Bytes asked by the client.
+        size_type interval;         //!< Interval it was sampled with.
+        bucket_map::value_type *bucket;
+    };
+
+    std::atomic<size_type> g_interval( 0 );
+    std::atomic<size_type> g_last_interval( 0 );
+
+    //! The profiler's state, built on first use and guarded by its mutex.
+    struct State {
+        std::mutex lock;
+        bucket_map buckets;
+        std::unordered_map<void *, Live> live;
+    };
+
+    State &state( ) {
+        static State *s = new State;    // Never destroyed: frees may come late.
+        return *s;
+    }
+
+    //! Draws the bytes until the next sample, exponential with mean _interval.
+    std::ptrdiff_t next_countdown( size_type _interval ) {
+        thread_local std::mt19937_64 rng( std::random_device{ }( ) );
+        std::uniform_real_distribution<double> uniform( 0.0, 1.0 );
+        return static_cast<std::ptrdiff_t>(-std::log(1.0 - uniform(rng)) * _interval) + 1;
+    }
+
+    //! Inverse of the chance that an object of _b bytes gets sampled.
+    double weight( size_type _b, size_type _interval ) {
+        return 1.0 / (1.0 - std::exp(-static_cast<double>(_b) / _interval));
+    }
+
+    //! Readable name of a return address.
+    std::string symbol( void *_addr ) {
+
+        Dl_info info;
+        if ( dladdr(_addr, &info) != 0 and info.dli_sname != nullptr ) {
+            int status = 0;
+            char *name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            std::string result = status == 0 ? name : info.dli_sname;
+            std::free(name);
+            // ';' separates the frames of a folded stack.
+            for ( auto &c : result )
+                if ( c == ';' ) c = ':';
+            return result;
+        }
+
+        char buffer[2 + 2 * sizeof(void *) + 1];
+        std::snprintf(buffer, sizeof(buffer), "%p", _addr);
+        return buffer;
+    }
+}
+
+void HeapProfiler::SetInterval( size_type _b ) {
+    g_interval = _b;
+    if ( _b != 0 )
+        g_last_interval = _b;
+    // Other threads notice once their current countdown runs out.
+    t_countdown = 0;
+}
+
+size_type HeapProfiler::Interval( ) {
+    return g_interval;
+}
+
+bool HeapProfiler::Sample( void *_p, size_type _b, StoragePool *_pool ) {
+
+    size_type interval = g_interval.load(std::memory_order_relaxed);
+    if ( interval == 0 ) {
+        t_countdown = OffCountdown;
+        return false;
+    }
+    t_countdown = next_countdown(interval);
+
+    void *frames[MaxFrames];
+    int depth = backtrace(frames, MaxFrames);
+    int skip = depth > SkipFrames ? SkipFrames : depth;
+    // Stored from the outermost caller to the allocation site.
+    Stack stack( frames + skip, frames + depth );
+    std::reverse(stack.begin( ), stack.end( ));
+
+    State &s = state( );
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    auto &entry = *s.buckets.insert( std::make_pair( std::make_pair(_pool, stack), Bucket( ) ) ).first;
+    entry.second.inuse_objs++;
+    entry.second.inuse_bytes += _b;
+    entry.second.alloc_objs++;
+    entry.second.alloc_bytes += _b;
+
+    Live live = { _b, interval, &entry };
+    s.live[_p] = live;
+    return true;
+}
+
+void HeapProfiler::Release( void *_p ) {
+
+    State &s = state( );
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    auto it = s.live.find(_p);
+    if ( it == s.live.end( ) )
+        return;
+
+    Bucket &bucket = it->second.bucket->second;
+    bucket.inuse_objs--;
+    bucket.inuse_bytes -= it->second.bytes;
+    s.live.erase(it);
+}
+
+void HeapProfiler::DumpFolded( std::ostream &_os ) {
+
+    State &s = state( );
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    // Estimated live bytes of each bucket.
+    std::map<const bucket_map::value_type *, double> bytes;
+    for ( auto &live : s.live )
+        bytes[live.second.bucket] += live.second.bytes * weight(live.second.bytes, live.second.interval);
+
+    for ( auto &entry : bytes ) {
+        const auto &key = entry.first->first;
+        _os << "pool@" << static_cast<void *>(key.first);
+        for ( auto *frame : key.second )
+            _os << ";" << symbol(frame);
+        _os << " " << static_cast<unsigned long long>(entry.second + 0.5) << "\n";
+    }
+}
+
+void HeapProfiler::DumpPprof( std::ostream &_os ) {
+
+    State &s = state( );
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    Bucket total;
+    for ( auto &entry : s.buckets ) {
+        total.inuse_objs += entry.second.inuse_objs;
+        total.inuse_bytes += entry.second.inuse_bytes;
+        total.alloc_objs += entry.second.alloc_objs;
+        total.alloc_bytes += entry.second.alloc_bytes;
+    }
+
+    // pprof scales the sampled counts back up from the rate after "heap_v2/".
+    _os << "heap profile: " << total.inuse_objs << ": " << total.inuse_bytes
+        << " [" << total.alloc_objs << ": " << total.alloc_bytes << "] @ heap_v2/"
+        << g_last_interval.load( ) << "\n";
+
+    for ( auto &entry : s.buckets ) {
+        const Bucket &b = entry.second;
+        _os << b.inuse_objs << ": " << b.inuse_bytes
+            << " [" << b.alloc_objs << ": " << b.alloc_bytes << "] @";
+        // pprof wants the allocation site first.
+        const Stack &stack = entry.first.second;
+        for ( auto it = stack.rbegin( ); it != stack.rend( ); ++it )
+            _os << " " << *it;
+        _os << "\n";
+    }
+
+    // Lets pprof map the addresses back to the binaries.
+    _os << "\nMAPPED_LIBRARIES:\n";
+    std::ifstream maps( "/proc/self/maps" );
+    if ( maps )
+        _os << maps.rdbuf( );
+}
@@ -14,12 +14,24 @@
 #include <random>	// std::random_device
 #include <cmath>	// std::ceil
 #include <cassert>	// assert
+#include <cstdint>	// std::uintptr_t
 #include <chrono>	// std::chrono
 #include <ctime>	// std::time_t
 #include <string>	// std::string
 #include <queue>	// std::priority_queue
+#include <algorithm>	// std::fill
+#include <vector>	// std::vector
+#include <coroutine>	// std::coroutine_handle
+#include <type_traits>	// std::is_same_v
 
 #include "../include/SLPool.hpp"
+#include "../include/PoolRouter.hpp"
+#include "../include/BitmapPool.hpp"
+#include "../include/FramePool.hpp"
+#include "../include/GenPool.hpp"
+#include "../include/ObjectPool.hpp"
+#include "../include/perf_counters.hpp"
+#include "../include/heap_profiler.hpp"
 #include "../include/mempool_common.hpp"
 
 typedef std::time_t tempo;
@@ -138,6 +150,347 @@ void StoragePoolTest(StoragePool *_pool, tempo _timeLimit)
 }
 /*}}}*/
 
+/**
+ * @brief Hardware counters of a batch of allocations and of its frees, each
+ *        in a window of its own, so the list walk of Allocate and the merges
+ *        of Free are not mixed up
+ * @param _pool A pointer to the pool to be used, nullptr for the operational system
+ * @param _name The name printed before the counters
+ * @param _pc The counters to be used
+ */
+void CounterTest(StoragePool *_pool, const char *_name, PerfCounters &_pc)
+/*{{{*/
+{
+    const int n = 10000;
+    std::vector<int *> areas(n);
+    unsigned seed = 5;
+
+    _pc.Start( );
+    for ( int i = 0; i < n; i++ )
+        areas[i] = _pool ? new(*_pool) int[1 + i % 10] : new int[1 + i % 10];
+    _pc.Stop( );
+    std::cout << ">>> " << _name << " per allocate:\n\t";
+    _pc.Report(std::cout, n);
+    std::cout << "\n";
+
+    // Freed in random order, so Free has to walk the list and merge both ways.
+    for ( int i = n - 1; i > 0; i-- )
+        std::swap(areas[i], areas[rand_r(&seed) % (i + 1)]);
+
+    _pc.Start( );
+    for ( int *p : areas )
+        delete[] p;
+    _pc.Stop( );
+    std::cout << ">>> " << _name << " per free:\n\t";
+    _pc.Report(std::cout, n);
+    std::cout << "\n";
+}
+/*}}}*/
+
+/**
+ * @brief Allocation sites for the heap profiler test: small, many objects
+ * @param _pool The pool to be used
+ * @param _out Where the objects are stored
+ * @param _n Number of objects
+ */
+__attribute__((noinline))
+void ProfileSmall(StoragePool &_pool, int **_out, int _n)
+{
+	for ( int i = 0; i < _n; i++ )
+		_out[i] = new(_pool) int[4];
+}
+
+/**
+ * @brief Allocation sites for the heap profiler test: large, few objects
+ * @param _pool The pool to be used
+ * @param _out Where the objects are stored
+ * @param _n Number of objects
+ */
+__attribute__((noinline))
+void ProfileLarge(StoragePool &_pool, int **_out, int _n)
+{
+	for ( int i = 0; i < _n; i++ )
+		_out[i] = new(_pool) int[256];
+}
+
+/**
+ * @brief Allocate/free time on a pool whose holes are all too small
+ * @param _pool A pointer to the pool to be used
+ * @param _bytes Number of bytes of the pool
+ * @param _keep Out of every _keep areas that fill the pool, all but one stay allocated
+ * @return Average time of an allocate/free pair, in ns
+ */
+double OccupancyTest(StoragePool *_pool, size_type _bytes, int _keep)
+/*{{{*/
+{
+    std::vector<void *> filler;
+    unsigned seed = 42;
+
+    // Fills all but the last 64Kb with areas of 16..256 bytes, then frees one
+    // in _keep of them: every hole is smaller than the timed requests below.
+    for ( size_type used = 0; used + 64 * 1024 < _bytes; ) {
+        size_type b = 16 + rand_r(&seed) % 241;
+        filler.push_back( _pool->Allocate(b) );
+        used += b + 16;
+    }
+    for ( auto i = 0u; i < filler.size( ); i += _keep )
+        _pool->Free( filler[i] );
+
+    int times = 10000;
+    auto start = std::chrono::steady_clock::now( );
+    for ( int i = 0; i < times; i++ ) {
+        void *p = _pool->Allocate( 512 + i % 512 );
+        _pool->Free( p );
+    }
+    auto end = std::chrono::steady_clock::now( );
+
+    for ( auto i = 0u; i < filler.size( ); i++ )
+        if ( i % _keep != 0 )
+            _pool->Free( filler[i] );
+
+    return std::chrono::duration<double, std::nano>(end - start).count( ) / times;
+}
+/*}}}*/
+
+/**
+ * @brief Allocate/free churn: random small objects replace each other
+ * @param _pool A pointer to the pool to be used
+ * @return Average time of an allocate/free pair, in ns
+ */
+double ChurnTest(StoragePool *_pool)
+/*{{{*/
+{
+    void *live[256] = { nullptr };
+    unsigned seed = 7;
+    int times = 1000000;
+
+    auto start = std::chrono::steady_clock::now( );
+    for ( int i = 0; i < times; i++ ) {
+        auto &slot = live[rand_r(&seed) % 256];
+        if ( slot != nullptr )
+            _pool->Free(slot);
+        slot = _pool->Allocate( 8 + rand_r(&seed) % 120 );
+    }
+    auto end = std::chrono::steady_clock::now( );
+
+    for ( auto *p : live )
+        if ( p != nullptr )
+            _pool->Free(p);
+
+    return std::chrono::duration<double, std::nano>(end - start).count( ) / times;
+}
+/*}}}*/
+
+/**
+ * @brief A coroutine that runs when resumed, and whose frame goes with it
+ * @tparam Frame Base of the promise, it decides where the frame comes from
+ */
+template < typename Frame >
+class Task
+/*{{{*/
+{
+	public:
+		struct promise_type : Frame {
+			Task get_return_object( ) {
+				return Task( std::coroutine_handle<promise_type>::from_promise(*this) );
+			}
+			std::suspend_always initial_suspend( ) noexcept { return { }; }
+			std::suspend_always final_suspend( ) noexcept { return { }; }
+			void return_value( int _v ) { m_value = _v; }
+			void unhandled_exception( ) { throw; }
+
+			int m_value = 0;	//!< The coroutine's result
+		};
+
+		explicit Task( std::coroutine_handle<promise_type> _h ) : m_handle(_h) { /*Empty*/ }
+		Task( Task &&_t ) noexcept : m_handle(_t.m_handle) { _t.m_handle = nullptr; }
+		~Task( ) { if ( m_handle ) m_handle.destroy( ); }
+
+		//! Where the coroutine's frame lives.
+		const void *Address( ) const { return m_handle.address( ); }
+
+		/**
+		 * @brief Runs the coroutine to the end
+		 * @return Its result
+		 */
+		int Run( ) {
+			while ( not m_handle.done( ) )
+				m_handle.resume( );
+			return m_handle.promise( ).m_value;
+		}
+
+	private:
+		std::coroutine_handle<promise_type> m_handle;	//!< The coroutine
+};
+/*}}}*/
+
+//! Frames from the global operator new.
+struct HeapFrame { };
+
+/**
+ * @brief Coroutine body for the frame test, with some state in its frame
+ * @param _seed Where the computation starts
+ */
+template < typename Frame >
+Task<Frame> Work(int _seed)
+{
+	int state[16];
+	for ( int i = 0; i < 16; i++ )
+		state[i] = _seed + i;
+	co_await std::suspend_always{ };
+	int sum = 0;
+	for ( int i = 0; i < 16; i++ )
+		sum += state[i];
+	co_return sum;
+}
+
+/**
+ * @brief Spawns and completes many coroutines, one at a time
+ * @param _n Number of coroutines
+ * @return Average time per coroutine, in ns
+ */
+template < typename Frame >
+double CoroutineTest(int _n)
+/*{{{*/
+{
+	long long check = 0;
+	auto start = std::chrono::steady_clock::now( );
+	for ( int i = 0; i < _n; i++ ) {
+		Task<Frame> task = Work<Frame>(i);
+		// A pooled frame is aligned as operator new must align; the driver's own
+		// global new only keeps the 8 bytes of its Tag in front of malloc's area.
+		if constexpr ( std::is_same_v<Frame, PooledFrame> )
+			assert( reinterpret_cast<std::uintptr_t>(task.Address( )) % FramePool::Align == 0 );
+		check += task.Run( );
+	}
+	auto end = std::chrono::steady_clock::now( );
+
+	// Sum of 16 consecutive ints from i, for every i.
+	assert( check == 16LL * _n * (_n - 1) / 2 + 120LL * _n );
+	return std::chrono::duration<double, std::nano>(end - start).count( ) / _n;
+}
+/*}}}*/
+
+/**
+ * @brief Fragmentation over time of a plain SLPool and of GenPools, on the same
+ *        workload: bursts of small areas that die young, and a trickle of big
+ *        ones that live long
+ */
+void FragmentationTest( )
+/*{{{*/
+{
+    const size_type bytes = 512 * 1024, young_bytes = 128 * 1024;
+    const int ticks = 5000, report = 500, max_life = 1000;
+
+    SLPool plain(bytes);
+    GenPool hinted(young_bytes, bytes - young_bytes);
+    GenPool predicted(young_bytes, bytes - young_bytes, true);
+    StoragePool *pools[] = { &plain, &hinted, &predicted };
+
+    // Areas to be freed at each tick, for each pool.
+    std::vector< std::vector<void *> > due[3];
+    for ( auto &d : due )
+        d.resize(ticks + max_life + 1);
+    int failures[3] = { 0, 0, 0 };
+    unsigned seed = 2018;
+
+    // Fragmentation: how much of the free space is not in the largest free area.
+    auto frag = [](size_type _free, size_type _largest) {
+        return _free == 0 ? 0.0 : 100.0 * (1.0 - static_cast<double>(_largest) / _free);
+    };
+
+    // Each GenPool is measured whole, regions included, to compare with the
+    // SLPool, and then on its own long-lived SLPool alone.
+    std::cout << ">>> tick | SLPool: frag% largest | GenPool (hints): frag% largest, long frag% largest, resets"
+              << " | GenPool (predicted): frag% largest, long frag% largest, resets\n";
+    for ( int t = 0; t < ticks; t++ ) {
+
+        for ( int k = 0; k < 3; k++ ) {
+            for ( void *p : due[k][t] )
+                pools[k]->Free(p);
+            due[k][t].clear( );
+        }
+
+        // A burst of young areas, and now and then an old one.
+        int burst = rand_r(&seed) % 21;
+        for ( int i = 0; i <= burst; i++ ) {
+            bool young = i < burst or rand_r(&seed) % 100 >= 20;
+            if ( i == burst and young ) break;
+            size_type b = young ? 100 + rand_r(&seed) % 601 : 800 + rand_r(&seed) % 1201;
+            int life = young ? 1 + rand_r(&seed) % 10 : 100 + rand_r(&seed) % (max_life - 99);
+
+            for ( int k = 0; k < 3; k++ ) {
+                try {
+                    void *p = k == 1 ? pools[k]->AllocateHinted(b, young ? StoragePool::SHORT_LIVED
+                                                                         : StoragePool::LONG_LIVED)
+                                     : pools[k]->Allocate(b);
+                    due[k][t + life].push_back(p);
+                }
+                catch ( std::bad_alloc & ) { failures[k]++; }
+            }
+        }
+
+        if ( (t + 1) % report == 0 ) {
+            size_type f[3], l[3], lf[3], ll[3];
+            plain.FreeStats(f[0], l[0]);
+            hinted.FreeStats(f[1], l[1]);
+            predicted.FreeStats(f[2], l[2]);
+            hinted.LongPool( ).FreeStats(lf[1], ll[1]);
+            predicted.LongPool( ).FreeStats(lf[2], ll[2]);
+            std::cout << "    " << t + 1
+                      << " | " << frag(f[0], l[0]) << " " << l[0]
+                      << " | " << frag(f[1], l[1]) << " " << l[1] << ", " << frag(lf[1], ll[1])
+                      << " " << ll[1] << ", " << hinted.Resets( )
+                      << " | " << frag(f[2], l[2]) << " " << l[2] << ", " << frag(lf[2], ll[2])
+                      << " " << ll[2] << ", " << predicted.Resets( ) << "\n";
+        }
+    }
+    std::cout << ">>> Failed allocations: SLPool " << failures[0] << ", GenPool (hints) "
+              << failures[1] << ", GenPool (predicted) " << failures[2] << "\n";
+
+    for ( int k = 0; k < 3; k++ )
+        for ( auto &d : due[k] )
+            for ( void *p : d )
+                pools[k]->Free(p);
+}
+/*}}}*/
+
+//! An object that owns a buffer: costly to build, cheap to reset.
+struct Buffer {
+	Buffer( ) : m_data(4096) { /*Empty*/ }
+	void reset( ) { std::fill(m_data.begin( ), m_data.end( ), 0); }
+
+	std::vector<char> m_data;	//!< The buffer
+};
+
+/**
+ * @brief Lends and gives back Buffers in small batches, as a request handler would
+ * @param _acquire Returns a Buffer
+ * @param _release Gives it back
+ * @return Average time of a Buffer, in ns
+ */
+template < typename Acquire, typename Release >
+double RecycleTest(Acquire _acquire, Release _release)
+/*{{{*/
+{
+	const int rounds = 20000, batch = 16;
+	decltype(_acquire( )) held[batch];
+
+	auto start = std::chrono::steady_clock::now( );
+	for ( int r = 0; r < rounds; r++ ) {
+		for ( int i = 0; i < batch; i++ ) {
+			held[i] = _acquire( );
+			held[i]->m_data[i] = static_cast<char>(r);
+		}
+		for ( int i = 0; i < batch; i++ )
+			_release(held[i]);
+	}
+	auto end = std::chrono::steady_clock::now( );
+
+	return std::chrono::duration<double, std::nano>(end - start).count( ) / (rounds * batch);
+}
+/*}}}*/
+
 int main(/* int argc, char **argv */)
 {
 	std::cout << "\n\e[34;1m>>>Subtitles:\e[0m\n"
@@ -217,6 +570,27 @@ int main(/* int argc, char **argv */)
     }
 	std::cout << ">>> Memory Manager time with Best-Fit: " << time_spent << " ns\n";
 
+    // Average Time with the Memory Manager with deferred coalescing
+	SLPool pool2(400, StoragePool::FIRST_FIT, SLPool::DEFERRED);
+	time_spent = 0;
+    for ( int i = 0; i < times; i++ ) {
+        start = std::chrono::steady_clock::now( );
+        for (int j = 1; j <= 10; j += 2) {
+            al1 = new(pool2) int[j];
+            al2 = new(pool2) int[j+1];
+            delete[] al1;
+            delete[] al2;
+        }
+
+        // The final time
+        end = std::chrono::steady_clock::now();
+        // Calculates the difference
+        auto diff = std::chrono::duration<double, std::nano>(end-start).count( );
+        // Calculates the average time using standard deviation
+        time_spent += (diff - time_spent)/(i+1);
+    }
+	std::cout << ">>> Memory Manager time with First-Fit, deferred coalescing: " << time_spent << " ns\n";
+
     // Average Time with the Operational System
     time_spent = 0;
     for ( int i = 0; i < times; i++ ) {
@@ -236,6 +610,211 @@ int main(/* int argc, char **argv */)
     }
     std::cout << ">>> Operational System time: " << time_spent << " ns\n";
 }
+/*}}}*/
+/*Hardware counters{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Hardware counters, allocations and frees apart.\e[0m\n";
+	PerfCounters pc;
+	SLPool ff(1024 * 1024, StoragePool::FIRST_FIT), bf(1024 * 1024, StoragePool::BEST_FIT);
+	PoolRouter router(4096, 1024 * 1024);
+
+	CounterTest(&ff, "Memory Manager with First-Fit", pc);
+	CounterTest(&bf, "Memory Manager with Best-Fit", pc);
+	CounterTest(&router, "Pool Router", pc);
+	CounterTest(nullptr, "Operational System", pc);
+}
+/*}}}*/
+/*Heap profiler{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Sampled heap profile (live bytes by call site).\e[0m\n";
+	SLPool pool(64 * 1024);
+	int *small[500], *large[20];
+
+	HeapProfiler::SetInterval(512);
+	ProfileSmall(pool, small, 500);
+	ProfileLarge(pool, large, 20);
+	// Half of the small objects die, the profile must show it.
+	for ( int i = 0; i < 250; i++ )
+		delete[] small[i];
+	HeapProfiler::DumpFolded(std::cout);
+	HeapProfiler::SetInterval(0);
+
+	for ( int i = 250; i < 500; i++ )
+		delete[] small[i];
+	for ( int i = 0; i < 20; i++ )
+		delete[] large[i];
+}
+/*}}}*/
+/*Bitmap against list on full pools{{{*/
+{
+	std::cout << "\n\e[34;1m>>> High occupancy, SLPool list against BitmapPool ("
+			  << BitmapPool::Engine( ) << ").\e[0m\n";
+	const int keeps[] = { 2, 4, 10 };
+	const size_type bytes = 4 * 1024 * 1024;
+	for ( int keep : keeps ) {
+		SLPool list(bytes);
+		BitmapPool bitmap(bytes);
+		std::cout << ">>> " << 100 - 100 / keep << "% occupied: SLPool "
+				  << OccupancyTest(&list, bytes, keep) << " ns, BitmapPool "
+				  << OccupancyTest(&bitmap, bytes, keep) << " ns\n";
+	}
+}
+/*}}}*/
+/*Eager against deferred coalescing{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Churn of small objects, eager against deferred coalescing.\e[0m\n";
+	SLPool eager(64 * 1024), deferred(64 * 1024, StoragePool::FIRST_FIT, SLPool::DEFERRED);
+	std::cout << ">>> Eager: " << ChurnTest(&eager) << " ns, Deferred: "
+			  << ChurnTest(&deferred) << " ns\n";
+}
+/*}}}*/
+/*Coroutine frames{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Coroutine frames, pooled against operator new.\e[0m\n";
+	const int n = 1000000;
+	std::cout << ">>> Operator new: " << CoroutineTest<HeapFrame>(n) << " ns, FramePool: "
+			  << CoroutineTest<PooledFrame>(n) << " ns per coroutine\n";
+}
+/*}}}*/
+/*Lifetime segregation{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Fragmentation over time, short and long lifetimes mixed.\e[0m\n";
+	FragmentationTest( );
+
+	// The same hints through new(pool, hint), given back by delete.
+	GenPool pool(16 * 1024, 64 * 1024);
+	size_type resets = pool.Resets( );
+	int *table = new(pool, StoragePool::LONG_LIVED) int[256]( );
+	for ( int i = 0; i < 1000; i++ ) {
+		int *scratch = new(pool, StoragePool::SHORT_LIVED) int[1 + i % 64];
+		auto *count = new(pool, StoragePool::SHORT_LIVED) size_type(i);
+		table[i % 256] += scratch[0] = static_cast<int>(*count);
+		delete count;
+		delete[] scratch;
+	}
+	delete[] table;
+	size_type free, largest;
+	pool.FreeStats(free, largest);
+	std::cout << ">>> new(pool, hint)/delete on a GenPool: " << pool.Resets( ) - resets
+			  << " region resets, " << free << " bytes free, largest " << largest << "\n";
+}
+/*}}}*/
+/*Heap map snapshot{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Map of a fragmented 4Mb pool, snapshot against view().\e[0m\n";
+	SLPool pool(4 * 1024 * 1024);
+	std::vector<void *> areas;
+	unsigned seed = 11;
+	try {
+		for ( ; ; )
+			areas.push_back( pool.Allocate(16 + rand_r(&seed) % 241) );
+	}
+	catch ( std::bad_alloc & ) { /*Full*/ }
+	for ( auto i = 0u; i < areas.size( ); i += 3 )
+		pool.Free(areas[i]);
+
+	// A first call with no room tells the size of the map.
+	std::vector<char> map( pool.snapshot(nullptr, 0) );
+	auto start = std::chrono::steady_clock::now( );
+	pool.snapshot(map.data( ), map.size( ));
+	auto end = std::chrono::steady_clock::now( );
+	double snapshot = std::chrono::duration<double, std::micro>(end - start).count( );
+
+	std::ofstream null("/dev/null");
+	auto *out = std::cout.rdbuf(null.rdbuf( ));
+	start = std::chrono::steady_clock::now( );
+	pool.view( );
+	end = std::chrono::steady_clock::now( );
+	std::cout.rdbuf(out);
+	double view = std::chrono::duration<double, std::micro>(end - start).count( );
+
+	std::cout << ">>> " << map.size( ) << " bytes of map, snapshot: " << snapshot
+			  << " us, view(): " << view << " us\n";
+
+	// Render it with: build/bin/heapmap [-svg] <file>
+	if ( const char *path = std::getenv("GREMLINS_HEAPMAP") ) {
+		std::ofstream file(path, std::ios::binary);
+		file.write(map.data( ), map.size( ));
+		std::cout << ">>> Heap map written to " << path << "\n";
+	}
+
+	for ( auto i = 0u; i < areas.size( ); i++ )
+		if ( i % 3 != 0 )
+			pool.Free(areas[i]);
+}
+/*}}}*/
+/*Object recycling{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Objects owning a buffer, recycled against new(pool)/delete.\e[0m\n";
+	SLPool pool(64 * 1024);
+	double fresh = RecycleTest( [&pool]( ) { return new(pool) Buffer; },
+								[]( Buffer *&_b ) { delete _b; } );
+
+	ObjectPool<Buffer> objects(pool);
+	double recycled = RecycleTest( [&objects]( ) { return objects.Acquire( ); },
+								   []( ObjectPool<Buffer>::handle_type &_b ) { _b.reset( ); } );
+	std::cout << ">>> new(pool)/delete: " << fresh << " ns, ObjectPool: " << recycled
+			  << " ns per object (" << objects.Built( ) << " built)\n";
+}
+/*}}}*/
+/*Mixed sizes through the router{{{*/
+{
+	std::cout << "\n\e[34;1m>>> Mixed sizes, from 16 bytes to 64 Kb, and a huge one apart.\e[0m\n";
+	const size_type sizes[] = { 16, 24, 48, 100, 256, 1000, 4096, 65536, 200000 };
+	const size_type n_sizes = sizeof(sizes)/sizeof(sizes[0]), n_pooled = n_sizes - 1;
+	char *ptrs[n_sizes];
+	PoolRouter router;
+
+	// Average time of new[]/delete[] of sizes [_from, _to), from a pool or
+	// from the Operational System (nullptr).
+	auto average = [&]( StoragePool *_pool, size_type _from, size_type _to ) {
+		std::chrono::steady_clock::time_point start, end;
+		auto time_spent = 0.0l;
+		int times = 10000;
+		for ( int i = 0; i < times; i++ ) {
+			start = std::chrono::steady_clock::now( );
+			for ( auto k = _from; k < _to; k++ )
+				ptrs[k] = _pool ? new(*_pool) char[sizes[k]] : new char[sizes[k]];
+			for ( auto k = _from; k < _to; k++ )
+				delete[] ptrs[k];
+			end = std::chrono::steady_clock::now( );
+			auto diff = std::chrono::duration<double, std::nano>(end-start).count( );
+			time_spent += (diff - time_spent)/(i+1);
+		}
+		return time_spent;
+	};
+
+	// The router maps every huge area and unmaps it when freed, with no reuse,
+	// so that size costs an mmap/munmap pair and is timed on its own.
+	std::cout << ">>> Pool Router time: " << average(&router, 0, n_pooled)
+			  << " ns, huge (" << sizes[n_pooled] << " bytes, mmap/munmap): "
+			  << average(&router, n_pooled, n_sizes) << " ns\n";
+	std::cout << ">>> Operational System time: " << average(nullptr, 0, n_pooled)
+			  << " ns, huge (" << sizes[n_pooled] << " bytes): "
+			  << average(nullptr, n_pooled, n_sizes) << " ns\n";
+
+	// Every tier must keep the client's data apart.
+	for ( auto k = 0u; k < n_sizes; k++ ) {
+		ptrs[k] = new(router) char[sizes[k]];
+		std::fill(ptrs[k], ptrs[k] + sizes[k], static_cast<char>(k));
+	}
+	for ( auto k = 0u; k < n_sizes; k++ ) {
+		assert( ptrs[k][0] == static_cast<char>(k) );
+		assert( ptrs[k][sizes[k] - 1] == static_cast<char>(k) );
+		delete[] ptrs[k];
+	}
+
+	// Every tier must align its areas as malloc does, wherever they land.
+	std::vector<void *> areas;
+	for ( int i = 0; i < 32; i++ ) {
+		for ( auto k = 0u; k < n_sizes; k++ ) {
+			areas.push_back( router.Allocate(sizes[k] + i) );
+			assert( reinterpret_cast<std::uintptr_t>(areas.back( )) % PoolRouter::Align == 0 );
+		}
+	}
+	for ( void *p : areas )
+		router.Free(p);
+}
 /*}}}*/
 	std::cout << "\n>>> Testing data maintenance.";
 
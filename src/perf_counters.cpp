@@ -0,0 +1,158 @@
+/**
+ * @file perf_counters.cpp
+ * @version 1.0
+ * @since Jun, 30.
+ * @date Jun, 30.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title gm::PerfCounters Class
+ */
+
+#include <iostream>
+
+#include <cstdint>      // To std::uint64_t
+#include <cstring>      // To std::memset
+#include "perf_counters.hpp"
+
+#ifdef __linux__
+#include <unistd.h>             // To syscall, read, close
+#include <sys/ioctl.h>          // To ioctl
+#include <sys/syscall.h>        // To SYS_perf_event_open
+#include <linux/perf_event.h>   // To perf_event_attr
+#endif
+
+using namespace gm;
+
+/**
+ * @brief gm::PerfCounters class implementation.
+ */
+
+#ifdef __linux__
+
+namespace {
+
+    //! Builds the perf_event_attr config of a hardware cache event.
+    constexpr std::uint64_t cache_event( std::uint64_t _cache, std::uint64_t _op, std::uint64_t _result ) {
+        return _cache | (_op << 8) | (_result << 16);
+    }
+
+    //! Type and config of each event, in the order of PerfCounters::event_type.
+    const struct { std::uint32_t type; std::uint64_t config; } k_events[PerfCounters::NumEvents] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                          PERF_COUNT_HW_CACHE_RESULT_MISS) },
+        { PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                                          PERF_COUNT_HW_CACHE_RESULT_MISS) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                          PERF_COUNT_HW_CACHE_RESULT_MISS) },
+    };
+
+    int open_event( std::uint32_t _type, std::uint64_t _config ) {
+
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = _type;
+        attr.config = _config;
+        attr.disabled = 1;
+        // Kernel time is left out, so the default paranoid level still allows it.
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+}
+
+PerfCounters::PerfCounters( ) {
+    for ( int i = 0; i < NumEvents; i++ ) {
+        m_fd[i] = open_event(k_events[i].type, k_events[i].config);
+        m_value[i] = 0;
+    }
+}
+
+PerfCounters::~PerfCounters( ) {
+    for ( int i = 0; i < NumEvents; i++ )
+        if ( m_fd[i] != -1 )
+            close(m_fd[i]);
+}
+
+void PerfCounters::Start( ) {
+    for ( int i = 0; i < NumEvents; i++ ) {
+        if ( m_fd[i] == -1 ) continue;
+        ioctl(m_fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(m_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void PerfCounters::Stop( ) {
+
+    for ( int i = 0; i < NumEvents; i++ )
+        if ( m_fd[i] != -1 )
+            ioctl(m_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+
+    for ( int i = 0; i < NumEvents; i++ ) {
+        m_value[i] = 0;
+        if ( m_fd[i] == -1 ) continue;
+
+        // { value, time enabled, time running }
+        std::uint64_t data[3] = { 0, 0, 0 };
+        if ( read(m_fd[i], data, sizeof(data)) != sizeof(data) or data[2] == 0 )
+            continue;
+
+        // When the kernel multiplexed the counter, scale up what it saw.
+        m_value[i] = static_cast<double>(data[0]) * data[1] / data[2];
+    }
+}
+
+#else
+
+PerfCounters::PerfCounters( ) {
+    for ( int i = 0; i < NumEvents; i++ ) {
+        m_fd[i] = -1;
+        m_value[i] = 0;
+    }
+}
+
+PerfCounters::~PerfCounters( ) { /*Empty*/ }
+
+void PerfCounters::Start( ) { /*Empty*/ }
+
+void PerfCounters::Stop( ) { /*Empty*/ }
+
+#endif
+
+bool PerfCounters::Any( ) const {
+    for ( int i = 0; i < NumEvents; i++ )
+        if ( Available(static_cast<event_type>(i)) )
+            return true;
+    return false;
+}
+
+const char *PerfCounters::Name( event_type _e ) {
+    static const char *const names[NumEvents] = {
+        "cycles", "instructions", "L1d-miss", "LLC-miss", "branch-miss", "dTLB-miss"
+    };
+    return names[_e];
+}
+
+void PerfCounters::Report( std::ostream &_os, double _ops ) const {
+
+    if ( not Any( ) ) {
+        _os << "(hardware counters unavailable)";
+        return;
+    }
+
+    for ( int i = 0; i < NumEvents; i++ ) {
+        auto e = static_cast<event_type>(i);
+        _os << Name(e) << ": ";
+        if ( Available(e) )
+            _os << m_value[i] / _ops;
+        else
+            _os << "n/a";
+        if ( i + 1 < NumEvents )
+            _os << "  ";
+    }
+}
@@ -0,0 +1,210 @@
+/**
+ * @file heapmap.cpp
+ * @version 1.0
+ * @since Jul, 06.
+ * @date Jul, 06.
+ * @author Oziel Alves (ozielalves@ufrn.edu.br)
+ * @author Daniel Guerra (daniel.guerra13@hotmail.com)
+ * @title Offline reader of the heap maps written by SLPool::snapshot
+ *
+ * Usage: heapmap [-svg] [-width N] <map file>
+ *
+ * Prints the arena as one line of N cells ('+' free, '#' used, '~' both),
+ * the fragmentation and histograms of the free and used areas by size.
+ * With -svg an SVG picture of the arena is written to stdout instead.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>	// std::atoi
+#include <cstring>	// std::strcmp
+#include <string>	// std::string
+#include <vector>	// std::vector
+#include "heap_map.hpp"
+
+using namespace gm;
+
+typedef std::size_t size_type;
+
+namespace {
+
+	//! An area of the map.
+	struct Area {
+		size_type m_offset;		//!< First block.
+		size_type m_length;		//!< Blocks.
+		bool m_free;			//!< Whether it is free.
+	};
+
+	/**
+	 * @brief Reads a heap map file
+	 * @return False, with a message on std::cerr, if it is not a valid map
+	 */
+	bool Load( const char *_path, HeapMapHeader &_header, std::vector<Area> &_areas ) {
+
+		std::ifstream in(_path, std::ios::binary);
+		if ( not in ) {
+			std::cerr << "heapmap: cannot open " << _path << "\n";
+			return false;
+		}
+
+		if ( not in.read(reinterpret_cast<char *>(&_header), sizeof(_header)) or
+			 _header.m_magic != HeapMapMagic ) {
+			std::cerr << "heapmap: " << _path << " is not a heap map\n";
+			return false;
+		}
+		if ( _header.m_version != HeapMapVersion ) {
+			std::cerr << "heapmap: unknown heap map version " << _header.m_version << "\n";
+			return false;
+		}
+
+		HeapMapRecord record;
+		for ( std::uint32_t i = 0; i < _header.m_records; i++ ) {
+			if ( not in.read(reinterpret_cast<char *>(&record), sizeof(record)) ) {
+				std::cerr << "heapmap: " << _path << " ends after " << i << " records\n";
+				return false;
+			}
+			_areas.push_back( { record.m_offset, record.m_length & ~HeapMapRecord::FreeBit,
+								(record.m_length & HeapMapRecord::FreeBit) != 0 } );
+		}
+		return true;
+	}
+
+	//! Index of the power of two bucket of _n: 1, 2-3, 4-7, ...
+	size_type Bucket( size_type _n ) {
+		size_type b = 0;
+		while ( _n > 1 ) {
+			_n >>= 1;
+			b++;
+		}
+		return b;
+	}
+
+	//! Prints a histogram of the areas (free or used) by size.
+	void Histogram( const std::vector<Area> &_areas, bool _free, size_type _block_size ) {
+
+		std::vector<size_type> count, blocks;
+		for ( const Area &a : _areas ) {
+			if ( a.m_free != _free )
+				continue;
+			size_type b = Bucket(a.m_length);
+			if ( b >= count.size( ) ) {
+				count.resize(b + 1, 0);
+				blocks.resize(b + 1, 0);
+			}
+			count[b]++;
+			blocks[b] += a.m_length;
+		}
+
+		// Bars are scaled to the most crowded bucket.
+		size_type most = 1;
+		for ( size_type c : count )
+			if ( c > most )
+				most = c;
+
+		std::cout << ( _free ? "Free" : "Used" ) << " areas by size (bytes: areas, total bytes)\n";
+		for ( size_type b = 0; b < count.size( ); b++ ) {
+			if ( count[b] == 0 )
+				continue;
+			size_type low = (size_type(1) << b) * _block_size;
+			std::cout << "  " << low << " - " << 2 * low - 1 << ": " << count[b] << ", "
+					  << blocks[b] * _block_size << " " << std::string((count[b] * 40 + most - 1) / most, '*')
+					  << "\n";
+		}
+	}
+
+	//! Prints the arena as _width cells, then the statistics.
+	void Text( const HeapMapHeader &_header, const std::vector<Area> &_areas, size_type _width ) {
+
+		size_type cell = (_header.m_blocks + _width - 1) / _width;
+		if ( cell == 0 )
+			cell = 1;
+
+		// Each cell is marked by the kinds of the blocks it covers.
+		std::string line((_header.m_blocks + cell - 1) / cell, ' ');
+		for ( const Area &a : _areas ) {
+			char mark = a.m_free ? '+' : '#';
+			for ( size_type c = a.m_offset / cell; c * cell < a.m_offset + a.m_length and c < line.size( ); c++ )
+				line[c] = ( line[c] == ' ' or line[c] == mark ) ? mark : '~';
+		}
+
+		size_type free = 0, largest = 0, n_free = 0;
+		for ( const Area &a : _areas ) {
+			if ( not a.m_free )
+				continue;
+			free += a.m_length;
+			n_free++;
+			if ( a.m_length > largest )
+				largest = a.m_length;
+		}
+
+		std::cout << "Arena: " << _header.m_blocks << " blocks of " << _header.m_block_size
+				  << " bytes, " << _areas.size( ) << " areas, " << cell << " blocks per cell\n"
+				  << "[" << line << "]\n"
+				  << "Free: " << free * _header.m_block_size << " bytes in " << n_free
+				  << " areas, largest " << largest * _header.m_block_size << " bytes\n"
+				  << "Fragmentation: "
+				  << ( free == 0 ? 0.0 : 100.0 * (1.0 - static_cast<double>(largest) / free) )
+				  << "% of the free space is outside the largest free area\n";
+
+		Histogram(_areas, true, _header.m_block_size);
+		Histogram(_areas, false, _header.m_block_size);
+	}
+
+	//! Writes the arena as rows of _width blocks, one rectangle per piece of area.
+	void Svg( const HeapMapHeader &_header, const std::vector<Area> &_areas, size_type _width ) {
+
+		const size_type scale = 4, rows = (_header.m_blocks + _width - 1) / _width;
+		std::cout << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << _width * scale
+				  << "\" height=\"" << rows * scale << "\">\n";
+
+		for ( const Area &a : _areas ) {
+			const char *color = a.m_free ? "#8c8" : "#c66";
+			// An area may wrap over several rows.
+			for ( size_type pos = a.m_offset; pos < a.m_offset + a.m_length; ) {
+				size_type row = pos / _width, col = pos % _width;
+				size_type n = _width - col < a.m_offset + a.m_length - pos ? _width - col
+																		  : a.m_offset + a.m_length - pos;
+				std::cout << "<rect x=\"" << col * scale << "\" y=\"" << row * scale
+						  << "\" width=\"" << n * scale << "\" height=\"" << scale
+						  << "\" fill=\"" << color << "\"/>\n";
+				pos += n;
+			}
+		}
+		std::cout << "</svg>\n";
+	}
+}
+
+int main( int argc, char **argv )
+{
+	bool svg = false;
+	size_type width = 0;
+	const char *path = nullptr;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( std::strcmp(argv[i], "-svg") == 0 )
+			svg = true;
+		else if ( std::strcmp(argv[i], "-width") == 0 and i + 1 < argc )
+			width = std::atoi(argv[++i]);
+		else
+			path = argv[i];
+	}
+
+	if ( path == nullptr ) {
+		std::cerr << "Usage: heapmap [-svg] [-width N] <map file>\n";
+		return 1;
+	}
+	if ( width == 0 )
+		width = svg ? 256 : 64;
+
+	HeapMapHeader header;
+	std::vector<Area> areas;
+	if ( not Load(path, header, areas) )
+		return 1;
+
+	if ( svg )
+		Svg(header, areas, width);
+	else
+		Text(header, areas, width);
+
+	return 0;
+}